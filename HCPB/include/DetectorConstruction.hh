@@ -1,33 +0,0 @@
-/// \file B1/include/DetectorConstruction.hh
-/// \brief Definition of the B1::DetectorConstruction class
-
-#ifndef B1DetectorConstruction_h
-#define B1DetectorConstruction_h 1
-
-#include "G4VUserDetectorConstruction.hh"
-
-class G4VPhysicalVolume;
-class G4LogicalVolume;
-
-namespace B1
-{
-
-/// Detector construction class to define materials and geometry.
-
-class DetectorConstruction : public G4VUserDetectorConstruction
-{
-  public:
-    DetectorConstruction() = default;
-    ~DetectorConstruction() override = default;
-
-    G4VPhysicalVolume* Construct() override;
-
-    G4LogicalVolume* GetScoringVolume() const { return fScoringVolume; }
-
-  protected:
-    G4LogicalVolume* fScoringVolume = nullptr;
-};
-
-}  // namespace B1
-
-#endif
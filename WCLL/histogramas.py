@@ -1,66 +1,73 @@
 import os
+import re
 import matplotlib.pyplot as plt
 import numpy as np
 
 # Get the directory where the script is located
 script_dir = os.path.dirname(os.path.abspath(__file__))
 
-# Filenames
-before_file         = os.path.join(script_dir, 'neutrons_before_W.txt')
-after_w_file        = os.path.join(script_dir, 'neutrons_after_W.txt')
-before_eurofer_file = os.path.join(script_dir, 'neutrons_before_EUROFER.txt')
-after_eurofer_file  = os.path.join(script_dir, 'neutrons_after_EUROFER.txt')
+# The simulation writes <quantity>_run<N>.txt; use the most recent run
+def latest_run_file(quantity):
+    runs = []
+    for name in os.listdir(script_dir):
+        match = re.fullmatch(re.escape(quantity) + r'_run(\d+)\.txt', name)
+        if match:
+            runs.append((int(match.group(1)), name))
+    if not runs:
+        return os.path.join(script_dir, quantity + '.txt')
+    return os.path.join(script_dir, max(runs)[1])
 
-# Function to read energy data from file
-def read_energies(filepath):
-    energies = []
-    if not os.path.exists(filepath):
-        print(f"Warning: File '{os.path.basename(filepath)}' not found.")
-        return energies
-    with open(filepath, 'r') as file:
-        for line in file:
-            try:
-                energy = float(line.strip())
-                energies.append(energy)
-            except ValueError:
-                continue  # Skip malformed lines
-    return energies
+# Binned spectra written by RunAction at the end of the run: columns
+# E_low, E_high [MeV], then per spectrum the crossings per source neutron,
+# their relative error and the same per unit lethargy
+spectra_file = latest_run_file('neutron_spectra')
+if not os.path.exists(spectra_file):
+    print(f"Nothing to plot. File '{os.path.basename(spectra_file)}' not found.")
+    exit()
+
+labels = []
+with open(spectra_file, 'r') as file:
+    for line in file:
+        if line.startswith('# E_low'):
+            labels = line.split()[3::3]
+data = np.loadtxt(spectra_file, comments='#', ndmin=2)
+edges = np.append(data[:, 0], data[-1, 1])
 
-# Read data
-energies_before         = read_energies(before_file)
-energies_after_w        = read_energies(after_w_file)
-energies_before_eurofer = read_energies(before_eurofer_file)
-energies_after_eurofer  = read_energies(after_eurofer_file)
+names = {
+    'before_W': 'Before W',
+    'after_W': 'After W',
+    'before_EUROFER': 'Before EUROFER',
+    'after_EUROFER': 'After EUROFER',
+}
 
 # Check if there's anything to plot
-if not (energies_before or energies_after_w or energies_before_eurofer or energies_after_eurofer):
-    print("Nothing to plot. All files are empty or missing.")
+if not data[:, 2:].any():
+    print("Nothing to plot. All spectra are empty.")
     exit()
 
-# Combine all energies to compute common bin edges
-all_energies = energies_before + energies_after_w + energies_before_eurofer + energies_after_eurofer
-min_energy = min(all_energies)
-max_energy = max(all_energies)
-
-# Define common bin edges
-num_bins = 130
-bins = np.linspace(min_energy, max_energy, num_bins + 1)
+# Lethargy-normalised spectra need positive bin edges
+lethargy = edges[0] > 0
 
 # Plotting
 plt.figure(figsize=(10, 6))
 
-if energies_before:
-    plt.hist(energies_before, bins=bins, alpha=0.5, label='Before W', edgecolor='black', linewidth=0.5)
-if energies_after_w:
-    plt.hist(energies_after_w, bins=bins, alpha=0.5, label='After W', edgecolor='black', linewidth=0.5)
-if energies_before_eurofer:
-    plt.hist(energies_before_eurofer, bins=bins, alpha=0.5, label='Before EUROFER', edgecolor='black', linewidth=0.5)
-if energies_after_eurofer:
-    plt.hist(energies_after_eurofer, bins=bins, alpha=0.5, label='After EUROFER', edgecolor='black', linewidth=0.5)
+centers = np.sqrt(edges[:-1] * edges[1:]) if lethargy else 0.5 * (edges[:-1] + edges[1:])
+for index, label in enumerate(labels):
+    column = 2 + 3 * index
+    values = data[:, column + 2] if lethargy else data[:, column]
+    errors = values * data[:, column + 1]
+    if values.any():
+        steps = plt.stairs(values, edges, label=names.get(label, label), linewidth=1.2)
+        plt.errorbar(centers, values, yerr=errors, fmt='none', ecolor=steps.get_edgecolor(),
+                     elinewidth=0.5)
+
+if lethargy:
+    plt.xscale('log')
 
 plt.tick_params(axis='both', which='major', labelsize=12)
 plt.xlabel('Neutron Energy (MeV)', fontsize=14)
-plt.ylabel('Counts', fontsize=14)
+plt.ylabel('Crossings per source neutron per unit lethargy' if lethargy
+           else 'Crossings per source neutron', fontsize=14)
 plt.title('Diseño WCLL: Blanket de aleación líquida $\mathrm{Pb_{83}Li{17}}$')
 plt.legend(fontsize=12)
 plt.grid()
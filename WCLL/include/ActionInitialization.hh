@@ -1,26 +0,0 @@
-/// \file B1/include/ActionInitialization.hh
-/// \brief Definition of the B1::ActionInitialization class
-
-#ifndef B1ActionInitialization_h
-#define B1ActionInitialization_h 1
-
-#include "G4VUserActionInitialization.hh"
-
-namespace B1
-{
-
-/// Action initialization class.
-
-class ActionInitialization : public G4VUserActionInitialization
-{
-  public:
-    ActionInitialization() = default;
-    ~ActionInitialization() override = default;
-
-    void BuildForMaster() const override;
-    void Build() const override;
-};
-
-}  // namespace B1
-
-#endif
@@ -1,17 +1,30 @@
 import os
+import re
 import matplotlib.pyplot as plt
 import numpy as np
 
 # File path
 script_dir = os.path.dirname(os.path.abspath(__file__))
-mult_file = os.path.join(script_dir, 'neutron_multiplication_depth.txt')
+
+# The simulation writes <quantity>_run<N>.txt; use the most recent run
+def latest_run_file(quantity):
+    runs = []
+    for name in os.listdir(script_dir):
+        match = re.fullmatch(re.escape(quantity) + r'_run(\d+)\.txt', name)
+        if match:
+            runs.append((int(match.group(1)), name))
+    if not runs:
+        return os.path.join(script_dir, quantity + '.txt')
+    return os.path.join(script_dir, max(runs)[1])
+
+mult_file = latest_run_file('neutron_multiplication_depth')
 
 # Read depth data (ignoring material name)
 def read_multiplication_depths(filepath):
-    depths = []
+    depths, weights = [], []
     if not os.path.exists(filepath):
         print(f"Warning: File '{os.path.basename(filepath)}' not found.")
-        return depths
+        return depths, weights
     with open(filepath, 'r') as file:
         for line in file:
             try:
@@ -19,12 +32,14 @@ def read_multiplication_depths(filepath):
                 if len(parts) >= 2:
                     z = float(parts[1])
                     depths.append(z)
+                    # Statistical weight: 1 in analog runs and in older files
+                    weights.append(float(parts[2]) if len(parts) > 2 else 1.0)
             except ValueError:
                 continue
-    return depths
+    return depths, weights
 
 # Load data
-multiplication_depths = read_multiplication_depths(mult_file)
+multiplication_depths, weights = read_multiplication_depths(mult_file)
 
 if not multiplication_depths:
     print("Nothing to plot. File is empty or missing.")
@@ -50,7 +65,7 @@ region_colors = {
 
 # Plot
 fig, ax = plt.subplots(figsize=(10, 5))
-ax.hist(multiplication_depths, bins=bins, color='blue', alpha=0.7,
+ax.hist(multiplication_depths, bins=bins, weights=weights, color='blue', alpha=0.7,
         edgecolor='black', linewidth=0.5)
 
 # Shade material regions and draw interface lines
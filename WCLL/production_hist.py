@@ -1,4 +1,5 @@
 import os
+import re
 import matplotlib.pyplot as plt
 import numpy as np
 
@@ -17,28 +18,42 @@ try:
 except NameError:
     script_dir = os.getcwd()  # Fallback for interactive environments
 
+# The simulation writes <quantity>_run<N>.txt; use the most recent run
+def latest_run_file(quantity):
+    runs = []
+    for name in os.listdir(script_dir):
+        match = re.fullmatch(re.escape(quantity) + r'_run(\d+)\.txt', name)
+        if match:
+            runs.append((int(match.group(1)), name))
+    if not runs:
+        return os.path.join(script_dir, quantity + '.txt')
+    return os.path.join(script_dir, max(runs)[1])
+
 # File paths
-triton_file = os.path.join(script_dir, 'triton_depth.txt')
-alpha_file  = os.path.join(script_dir, 'alpha_depth.txt')
+triton_file = latest_run_file('triton_depth')
+alpha_file  = latest_run_file('alpha_depth')
 
 # Function to read raw Z-position data (in cm)
 def read_depths(filepath):
-    depths = []
+    depths, weights = [], []
     if not os.path.exists(filepath):
         print(f"Warning: File '{os.path.basename(filepath)}' not found.")
-        return depths
+        return depths, weights
     with open(filepath, 'r') as file:
         for line in file:
             try:
-                z = float(line.strip())
+                columns = line.split()
+                z = float(columns[0])
                 depths.append(z)
-            except ValueError:
+                # Statistical weight: 1 in analog runs and in older files
+                weights.append(float(columns[1]) if len(columns) > 1 else 1.0)
+            except (ValueError, IndexError):
                 continue
-    return depths
+    return depths, weights
 
 # Read raw global Z-positions
-triton_depths = read_depths(triton_file)
-alpha_depths  = read_depths(alpha_file)
+triton_depths, triton_weights = read_depths(triton_file)
+alpha_depths, alpha_weights   = read_depths(alpha_file)
 
 # Shift so that z = -52.0 cm becomes depth = 0 cm
 depth_offset = +29.5  # cm
@@ -88,7 +103,7 @@ def annotate_regions(ax):
 
 # Plot Tritium (top)
 if triton_depths:
-    ax1.hist(triton_depths, bins=bins, alpha=0.7, color='green',
+    ax1.hist(triton_depths, bins=bins, weights=triton_weights, alpha=0.7, color='green',
              edgecolor='black', linewidth=0.5)
     ax1.set_ylabel('Tritium Counts', fontsize=16)
     ax1.set_title('Tritium Production Depth', fontsize=16)
@@ -99,7 +114,7 @@ if triton_depths:
 
 # Plot Helium (bottom)
 if alpha_depths:
-    ax2.hist(alpha_depths, bins=bins, alpha=0.7, color='purple',
+    ax2.hist(alpha_depths, bins=bins, weights=alpha_weights, alpha=0.7, color='purple',
              edgecolor='black', linewidth=0.5)
     ax2.set_ylabel('Helium Counts', fontsize=16)
     ax2.set_title('Helium Production Depth', fontsize=16)
@@ -0,0 +1,48 @@
+import os
+import re
+import subprocess
+import sys
+
+# Figure of merit of the neutron variance reduction against the analog run.
+# Run from the build directory, next to exampleB1: biasing_bench.py [concept]
+script_dir = os.path.dirname(os.path.abspath(__file__))
+executable = os.path.join(script_dir, 'exampleB1')
+macro = 'run.mac'
+summary_file = os.path.join(script_dir, 'neutron_spectrum.txt')
+concept = sys.argv[1] if len(sys.argv) > 1 else 'HCPB'
+
+# (label, -b argument, macro); the weight windows come from the pilot and
+# refinement runs of ww.mac, its last run is the one measured
+variants = [
+    ('analog', 'none', macro),
+    ('importance', 'importance', macro),
+    ('weightwindow', 'weightwindow', 'ww.mac'),
+    ('crosssection', 'crosssection', 'xs.mac'),
+    ('forcedcollision', 'forcedcollision', 'fc.mac'),
+]
+
+# Batch statistics lines of the run summary
+quantities = ['current:after_EUROFER', 'current:before_EUROFER', 'tbr_analog']
+batch_pattern = r'{}: ([0-9.eE+-]+).*?\(rel\. error ([0-9.eE+-]+), FOM ([0-9.eE+-]+) /s\)'
+
+def measure(biasing, macro):
+    subprocess.run([executable, macro, '-c', concept, '-b', biasing], cwd=script_dir,
+                   stdout=subprocess.DEVNULL, check=True)
+    with open(summary_file, 'r') as file:
+        text = file.read()
+    results = {}
+    for quantity in quantities:
+        mean, error, fom = re.findall(batch_pattern.format(re.escape(quantity)), text)[-1]
+        results[quantity] = (float(mean), float(error), float(fom))
+    return results
+
+results = [(label, measure(biasing, macro)) for label, biasing, macro in variants]
+reference = results[0][1]
+
+for quantity in quantities:
+    print(quantity)
+    for label, values in results:
+        mean, error, fom = values[quantity]
+        gain = fom / reference[quantity][2] if reference[quantity][2] > 0 else 0.0
+        print(f"  {label:12s} {mean:12.5g} per event, rel. error {error:8.4f}, "
+              f"FOM {fom:10.4g} /s, gain {gain:7.2f}")
@@ -0,0 +1,212 @@
+/// \file exampleB1.cc
+/// \brief Main program of the B1 example
+
+#include "ActionInitialization.hh"
+#include "DetectorConstruction.hh"
+#include "ImportanceGeometry.hh"
+#include "Logger.hh"
+#include "NeutronicsPhysicsList.hh"
+#include "ScanDriver.hh"
+#include "QGSP_BIC_HP.hh"
+
+#include "G4GenericBiasingPhysics.hh"
+#include "G4GeometrySampler.hh"
+#include "G4ImportanceBiasing.hh"
+#include "G4ParallelWorldPhysics.hh"
+#include "G4RunManagerFactory.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "G4SteppingVerbose.hh"
+#include "G4UIExecutive.hh"
+#include "G4UImanager.hh"
+#include "G4VisExecutive.hh"
+#include "G4WeightWindowAlgorithm.hh"
+#include "G4WeightWindowBiasing.hh"
+
+#include <cstdlib>
+
+using namespace B1;
+
+namespace
+{
+
+void PrintUsage()
+{
+  G4cerr << " Usage: " << G4endl;
+  G4cerr << " exampleB1 [macro] [-m macro] [-t nThreads] [-r Serial|MT|Tasking|Default]"
+         << " [-c WCLL|HCPB] [-g layerStackFile]"
+         << " [-p QGSP_BIC_HP|neutronics]"
+         << " [-b none|importance|weightwindow|crosssection|forcedcollision]" << G4endl;
+  G4cerr << "   note: -t option is ignored in sequential mode; it can also be set"
+         << G4endl;
+  G4cerr << "         with /run/numberOfThreads before /run/initialize" << G4endl;
+  G4cerr << "   -c selects the blanket concept <concept>.stack (default WCLL)," << G4endl;
+  G4cerr << "   -g any layer stack file" << G4endl;
+  G4cerr << "   -p physics list (default QGSP_BIC_HP); neutronics enables /B1/physics/"
+         << G4endl;
+  G4cerr << "   -b neutron variance reduction (default none); importance and"
+         << " weightwindow enable /B1/importance/ and /B1/ww/," << G4endl;
+  G4cerr << "      crosssection enables /B1/xs/, forcedcollision"
+         << " /B1/geometry/forceCollision" << G4endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+  // Evaluate arguments
+  G4String macro;
+  G4int nThreads = 0;
+  G4String runManagerType = "Default";
+  G4String stackFile = DetectorConstruction::GetConceptStackFile("WCLL");
+  G4String physicsName = "QGSP_BIC_HP";
+  G4String biasing = "none";
+  for (G4int i = 1; i < argc; ++i) {
+    G4String arg = argv[i];
+    if (arg == "-m" && i + 1 < argc) {
+      macro = argv[++i];
+    }
+    else if (arg == "-t" && i + 1 < argc) {
+      nThreads = std::atoi(argv[++i]);
+    }
+    else if (arg == "-r" && i + 1 < argc) {
+      runManagerType = argv[++i];
+    }
+    else if (arg == "-c" && i + 1 < argc) {
+      stackFile = DetectorConstruction::GetConceptStackFile(argv[++i]);
+    }
+    else if (arg == "-g" && i + 1 < argc) {
+      stackFile = argv[++i];
+    }
+    else if (arg == "-p" && i + 1 < argc) {
+      physicsName = argv[++i];
+    }
+    else if (arg == "-b" && i + 1 < argc) {
+      biasing = argv[++i];
+    }
+    else if (arg[0] != '-' && macro.empty()) {
+      macro = arg;
+    }
+    else {
+      PrintUsage();
+      return 1;
+    }
+  }
+
+  if ((physicsName != "QGSP_BIC_HP" && physicsName != "neutronics")
+      || (biasing != "none" && biasing != "importance" && biasing != "weightwindow"
+          && biasing != "crosssection" && biasing != "forcedcollision"))
+  {
+    PrintUsage();
+    return 1;
+  }
+
+  // Detect interactive mode (if no macro) and define UI session
+  G4UIExecutive* ui = nullptr;
+  if (macro.empty()) {
+    ui = new G4UIExecutive(argc, argv);
+  }
+
+  // Use G4SteppingVerboseWithUnits
+  G4int precision = 4;
+  G4SteppingVerbose::UseBestUnit(precision);
+
+  // Construct the run manager: MT or tasking when Geant4 is built with
+  // multithreading, unless overridden by -r or G4RUN_MANAGER_TYPE
+  auto runManager = G4RunManagerFactory::CreateRunManager(
+    G4RunManagerFactory::GetType(runManagerType));
+  if (nThreads > 0) {
+    runManager->SetNumberOfThreads(nThreads);
+  }
+
+  // Set mandatory initialization classes
+  auto detector = new DetectorConstruction(stackFile);
+  runManager->SetUserInitialization(detector);
+
+  G4VModularPhysicsList* physicsList = nullptr;
+  if (physicsName == "QGSP_BIC_HP") {
+    physicsList = new QGSP_BIC_HP;
+  }
+  else {
+    physicsList = new NeutronicsPhysicsList(&detector->GetVolumeRegistry());
+  }
+  physicsList->SetVerboseLevel(1);
+  // Applies the user limits of the /B1/region/ regions
+  physicsList->RegisterPhysics(new G4StepLimiterPhysics());
+
+  // Neutron variance reduction: biased cross sections, forced collisions in
+  // thin volumes, or splitting and roulette on a parallel geometry of z
+  // cells, by importance or against energy-dependent weight windows
+  G4GeometrySampler* sampler = nullptr;
+  G4VWeightWindowAlgorithm* windowAlgorithm = nullptr;
+  if (biasing == "crosssection") {
+    // Scaled inelastic cross section in the breeder and multiplier slabs
+    auto biasingPhysics = new G4GenericBiasingPhysics();
+    biasingPhysics->Bias("neutron", {"neutronInelastic"});
+    physicsList->RegisterPhysics(biasingPhysics);
+    detector->EnableCrossSectionBiasing();
+  }
+  else if (biasing == "forcedcollision") {
+    // Every neutron process is wrapped: the uncollided copy must not interact
+    auto biasingPhysics = new G4GenericBiasingPhysics();
+    biasingPhysics->Bias("neutron");
+    physicsList->RegisterPhysics(biasingPhysics);
+    detector->EnableForcedCollision();
+  }
+  else if (biasing != "none") {
+    G4bool importance = (biasing == "importance");
+    G4String parallelName = importance ? "ImportanceWorld" : "WeightWindowWorld";
+    auto cells = new ImportanceGeometry(parallelName, &detector->GetVolumeRegistry(),
+                                        importance ? ImportanceGeometry::kImportance
+                                                   : ImportanceGeometry::kWeightWindow);
+    detector->RegisterParallelWorld(cells);
+    sampler = new G4GeometrySampler(cells->GetWorldVolume(), "neutron");
+    sampler->SetParallel(true);
+    if (importance) {
+      physicsList->RegisterPhysics(new G4ImportanceBiasing(sampler, parallelName));
+    }
+    else {
+      // Windows are checked after collisions too: they depend on energy
+      windowAlgorithm = new G4WeightWindowAlgorithm(WeightWindowMesh::kUpperFactor,
+                                                    WeightWindowMesh::kSurvivalFactor,
+                                                    WeightWindowMesh::kMaxSplits);
+      physicsList->RegisterPhysics(new G4WeightWindowBiasing(sampler, windowAlgorithm,
+                                                             onBoundaryAndCollision,
+                                                             parallelName));
+    }
+    physicsList->RegisterPhysics(new G4ParallelWorldPhysics(parallelName));
+  }
+  runManager->SetUserInitialization(physicsList);
+
+  runManager->SetUserInitialization(new ActionInitialization());
+
+  // /B1/log/ commands controlling the diagnostic output
+  auto loggerMessenger = new LoggerMessenger();
+
+  // /B1/geometry/ and /B1/scan/ commands: geometry variants in one process
+  auto scanDriver = new ScanDriver(detector);
+
+  // Initialize visualization
+  auto visManager = new G4VisExecutive(argc, argv);
+  visManager->Initialize();
+
+  // Get the UI manager
+  auto UImanager = G4UImanager::GetUIpointer();
+
+  // Run in batch or interactive mode
+  if (!ui) {
+    G4String command = "/control/execute ";
+    UImanager->ApplyCommand(command + macro);
+  } else {
+    UImanager->ApplyCommand("/control/execute init_vis.mac");
+    ui->SessionStart();
+    delete ui;
+  }
+
+  // Clean up
+  delete scanDriver;
+  delete loggerMessenger;
+  delete visManager;
+  delete runManager;
+  delete sampler;
+  delete windowAlgorithm;
+}
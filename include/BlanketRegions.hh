@@ -0,0 +1,103 @@
+/// \file B1/include/BlanketRegions.hh
+/// \brief Definition of the B1::BlanketRegions and B1::RegionMessenger classes
+
+#ifndef B1BlanketRegions_h
+#define B1BlanketRegions_h 1
+
+#include "G4UImessenger.hh"
+#include "VolumeRegistry.hh"
+#include "globals.hh"
+
+class G4LogicalVolume;
+class G4Region;
+class G4UIdirectory;
+class G4UIcommand;
+
+namespace B1
+{
+
+class RegionMessenger;
+
+/// One G4Region per functional zone of the blanket, with its own
+/// production cuts and user limits.
+///
+/// The zone of a slab follows from its VolumeKind: the back plate and
+/// other structures share the Structure zone, while the world, envelope
+/// and containers stay in the default region. A zone uses the default
+/// cuts until a cut is set for it; the cuts of the other particles are
+/// then copied from the defaults. User limits (maximum step, minimum
+/// kinetic energy of charged particles, maximum time) need
+/// G4StepLimiterPhysics, which exampleB1 registers in either physics list.
+///
+/// The regions are created once, on the master, and survive geometry
+/// rebuilds: Detach() must be called while the old volumes still exist.
+
+class BlanketRegions
+{
+  public:
+    enum Zone : G4int
+    {
+      kFirstWallZone,
+      kMultiplierZone,
+      kBreederZone,
+      kStructureZone,
+      kNumberOfZones,
+      kOutside = kNumberOfZones  // default region: world, envelope, containers
+    };
+
+    BlanketRegions();
+    ~BlanketRegions();
+
+    static Zone GetZone(VolumeRegistry::VolumeKind kind)
+    {
+      switch (kind) {
+        case VolumeRegistry::kFirstWall: return kFirstWallZone;
+        case VolumeRegistry::kMultiplier: return kMultiplierZone;
+        case VolumeRegistry::kBreeder: return kBreederZone;
+        case VolumeRegistry::kBackPlate:
+        case VolumeRegistry::kStructure: return kStructureZone;
+        default: return kOutside;
+      }
+    }
+    // Region names; "World" for kOutside
+    static const char* GetZoneName(G4int zone);
+
+    // Construction: makes the logical volume a root of its zone's region
+    void Attach(G4LogicalVolume* logical, VolumeRegistry::VolumeKind kind);
+    // Before the volumes are deleted by a geometry rebuild
+    void Detach();
+
+    // particle is gamma, e-, e+, proton or all
+    void SetCut(Zone zone, G4double cut, const G4String& particle);
+    void SetMaxStep(Zone zone, G4double step);
+    void SetMinKineticEnergy(Zone zone, G4double energy);
+    void SetMaxTime(Zone zone, G4double time);
+
+  private:
+    G4Region* fRegions[kNumberOfZones] = {};
+    RegionMessenger* fMessenger = nullptr;
+};
+
+/// /B1/region/ commands; master only, the regions are shared
+
+class RegionMessenger : public G4UImessenger
+{
+  public:
+    RegionMessenger(BlanketRegions* regions);
+    ~RegionMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    BlanketRegions* fRegions = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcommand* fCutCmd = nullptr;
+    G4UIcommand* fMaxStepCmd = nullptr;
+    G4UIcommand* fMinEkinCmd = nullptr;
+    G4UIcommand* fMaxTimeCmd = nullptr;
+};
+
+}  // namespace B1
+
+#endif
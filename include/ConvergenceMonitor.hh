@@ -0,0 +1,96 @@
+/// \file B1/include/ConvergenceMonitor.hh
+/// \brief Definition of the B1::ConvergenceMonitor class
+
+#ifndef B1ConvergenceMonitor_h
+#define B1ConvergenceMonitor_h 1
+
+#include "globals.hh"
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace B1
+{
+
+/// Batch-means statistics shared by all threads, with a stopping rule.
+///
+/// Each thread sums its per-event scores over a batch of events and
+/// submits the batch sums here; the last batch of a thread is usually
+/// shorter, so the means and errors are ratio estimates weighted by the
+/// events of each batch. After every submission the monitor
+/// checks the stopping rule (relative error of one quantity below a
+/// target, or wall time exceeded) and raises a flag that every thread
+/// polls at the end of each event to abort its event loop. A second,
+/// independent rule raises the flag that lets the stacking action drop
+/// its deferred EM secondaries once a neutron tally has converged.
+
+class ConvergenceMonitor
+{
+  public:
+    static ConvergenceMonitor* Instance();
+
+    // Stopping rule, set from the master UI between runs
+    void SetBatchSize(G4int events) { fBatchSize = events; }
+    void SetMinBatches(G4int batches) { fMinBatches = batches; }
+    void SetTarget(G4double relativeError, const G4String& quantity);
+    void SetMaxWallTime(G4double seconds) { fMaxWallTime = seconds; }
+
+    G4int GetBatchSize() const { return fBatchSize; }
+
+    // Deferred EM secondaries are dropped once this quantity has converged
+    void SetDropTarget(G4double relativeError, const G4String& quantity);
+
+    // Master, before the workers start
+    void BeginRun(const std::vector<G4String>& quantities);
+
+    // Any thread: sums over one batch of nofEvents events
+    void AddBatch(const std::vector<G4double>& sums, G4int nofEvents);
+
+    G4bool StopRequested() const { return fStop.load(std::memory_order_relaxed); }
+    G4bool DropRequested() const { return fDrop.load(std::memory_order_relaxed); }
+
+    // Master, after the workers have finished
+    G4int GetNumberOfBatches() const { return fNBatches; }
+    G4int GetNumberOfQuantities() const { return static_cast<G4int>(fQuantities.size()); }
+    const G4String& GetQuantity(G4int i) const { return fQuantities[i]; }
+    G4double GetMean(G4int i) const;
+    G4double GetRelativeError(G4int i) const;
+    const G4String& GetStopReason() const { return fStopReason; }
+    // Batches submitted when the drop rule was met, -1 if it was not
+    G4int GetDropBatch() const { return fDropBatch; }
+
+  private:
+    ConvergenceMonitor() = default;
+
+    G4double WallTime() const;
+    G4double RelativeErrorUnlocked(G4int i) const;
+
+    G4int fBatchSize = 1000;
+    G4int fMinBatches = 10;
+    G4double fTargetError = 0.;  // 0: no relative error rule
+    G4String fTargetName = "tbr_analog";
+    G4double fMaxWallTime = 0.;  // s, 0: no wall time rule
+    G4double fDropError = 0.;    // 0: deferred secondaries are never dropped
+    G4String fDropName = "tbr_analog";
+
+    std::vector<G4String> fQuantities;
+    G4int fTargetIndex = -1;
+    G4int fDropIndex = -1;
+    G4int fDropBatch = -1;
+    G4int fNBatches = 0;
+    std::vector<G4double> fSum;   // of batch sums
+    std::vector<G4double> fSum2;
+    std::vector<G4double> fSumN;  // of batch sums times batch events
+    G4double fNEvents = 0.;
+    G4double fNEvents2 = 0.;      // sum of squared batch events
+    std::chrono::steady_clock::time_point fStart;
+
+    std::atomic<G4bool> fStop{false};
+    std::atomic<G4bool> fDrop{false};
+    G4String fStopReason;
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,140 @@
+/// \file B1/include/CrossSectionBiasing.hh
+/// \brief Definition of the B1::CrossSectionBiasing class
+
+#ifndef B1CrossSectionBiasing_h
+#define B1CrossSectionBiasing_h 1
+
+#include "VolumeRegistry.hh"
+
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4Track.hh"
+#include "G4VBiasingOperator.hh"
+#include "globals.hh"
+
+#include <cmath>
+#include <map>
+
+class G4BOptnChangeCrossSection;
+
+namespace B1
+{
+
+/// Generic-biasing operator that scales the neutron inelastic cross
+/// section in the breeder and multiplier slabs (exampleB1 -b crosssection).
+///
+/// Geant4 samples the reaction channels of an isotope inside one
+/// neutronInelastic process, so a channel is biased through the volumes
+/// where it dominates: the tritium channel, Li-6(n,t), in the breeder
+/// slabs, the multiplication channel, Be-9(n,2n), in the multiplier
+/// slabs. Each has its own factor (/B1/xs/factor). An interaction sampled
+/// from the biased cross section gets the weight sigma/sigma_biased, which
+/// its tritons, alphas and neutrons inherit; a neutron that flies on gains
+/// weight continuously along the step where the cross section is raised,
+/// exp((sigma_biased - sigma) l), and loses it where it is lowered. The
+/// stepping action takes that into account through GetWeightedLength()
+/// and GetSurvivalFactor().
+///
+/// There is one operator per thread, created with the sensitive detectors
+/// and attached again to the new slabs after a geometry rebuild. The
+/// factors are kept by the run action of each thread, the master included,
+/// which passes them to the operator at the start of every run.
+
+class CrossSectionBiasing : public G4VBiasingOperator
+{
+  public:
+    enum Channel : G4int
+    {
+      kTritiumChannel,         // breeder slabs
+      kMultiplicationChannel,  // multiplier slabs
+      kNumberOfChannels
+    };
+
+    CrossSectionBiasing(const VolumeRegistry* volumes);
+    ~CrossSectionBiasing() override;
+
+    // Operator of this thread; null without -b crosssection
+    static CrossSectionBiasing* GetInstance() { return fInstance; }
+
+    // Channel biased in a volume of this kind, or -1
+    static G4int GetChannel(VolumeRegistry::VolumeKind kind)
+    {
+      return kind == VolumeRegistry::kBreeder      ? kTritiumChannel
+             : kind == VolumeRegistry::kMultiplier ? kMultiplicationChannel
+                                                   : -1;
+    }
+    static const char* GetChannelName(G4int channel);
+
+    void SetFactor(Channel channel, G4double factor) { fFactors[channel] = factor; }
+    G4double GetFactor(G4int channel) const { return fFactors[channel]; }
+
+    void StartRun() override;
+
+    // Integral of the weight along the current step of the track, per unit
+    // pre-step weight: the step length when the step is not biased
+    G4double GetWeightedLength(const G4Track* track, G4double stepLength) const
+    {
+      G4double excess = GetExcess(track);
+      return (excess != 0.) ? std::expm1(excess * stepLength) / excess : stepLength;
+    }
+    // Weight at the end of the flight, before any interaction there, per
+    // unit pre-step weight: the analog over the biased non-interaction
+    // probability, exp(-sigma l) / exp(-sigma_biased l)
+    G4double GetSurvivalFactor(const G4Track* track, G4double stepLength) const
+    {
+      return std::exp(GetExcess(track) * stepLength);
+    }
+
+  private:
+    G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+      const G4Track* track, const G4BiasingProcessInterface* callingProcess) override;
+    G4VBiasingOperation* ProposeFinalStateBiasingOperation(
+      const G4Track*, const G4BiasingProcessInterface*) override
+    {
+      return nullptr;
+    }
+    G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
+      const G4Track*, const G4BiasingProcessInterface*) override
+    {
+      return nullptr;
+    }
+
+    using G4VBiasingOperator::OperationApplied;
+    void OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                          G4BiasingAppliedCase biasingCase,
+                          G4VBiasingOperation* occurenceOperationApplied,
+                          G4double weightForOccurenceInteraction,
+                          G4VBiasingOperation* finalStateOperationApplied,
+                          const G4VParticleChange* particleChangeProduced) override;
+
+    // (sigma_biased - sigma) of the step being taken, 0 for other steps.
+    // The step is identified by event, track ID and step number: track
+    // objects are recycled, so their address may come back in a later track
+    G4double GetExcess(const G4Track* track) const
+    {
+      return (track->GetTrackID() == fTrackID && track->GetCurrentStepNumber() == fStepNumber
+              && GetEventID() == fEventID)
+               ? fExcess
+               : 0.;
+    }
+    static G4int GetEventID()
+    {
+      const G4Event* event = G4EventManager::GetEventManager()->GetConstCurrentEvent();
+      return event ? event->GetEventID() : -1;
+    }
+
+    static G4ThreadLocal CrossSectionBiasing* fInstance;
+
+    const VolumeRegistry* fVolumes = nullptr;
+    G4double fFactors[kNumberOfChannels] = {1., 1.};
+    std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*> fOperations;
+
+    G4int fEventID = -1;
+    G4int fTrackID = 0;
+    G4int fStepNumber = 0;
+    G4double fExcess = 0.;
+};
+
+}  // namespace B1
+
+#endif
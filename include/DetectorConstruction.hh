@@ -0,0 +1,91 @@
+/// \file B1/include/DetectorConstruction.hh
+/// \brief Definition of the B1::DetectorConstruction class
+
+#ifndef B1DetectorConstruction_h
+#define B1DetectorConstruction_h 1
+
+#include "G4VUserDetectorConstruction.hh"
+#include "BlanketRegions.hh"
+#include "LayerStack.hh"
+#include "VolumeRegistry.hh"
+
+#include <vector>
+
+class G4VPhysicalVolume;
+class G4LogicalVolume;
+
+namespace B1
+{
+
+/// Detector construction class to define materials and geometry.
+///
+/// The blanket is built from a LayerStack file; the scored volumes and the
+/// interface crossings are derived from the kinds of its layers, and so
+/// is the region (first wall, multiplier, breeder, structure) of each slab.
+
+class DetectorConstruction : public G4VUserDetectorConstruction
+{
+  public:
+    explicit DetectorConstruction(const G4String& stackFile);
+    ~DetectorConstruction() override = default;
+
+    G4VPhysicalVolume* Construct() override;
+    // Per thread: the cross-section biasing operator, if enabled
+    void ConstructSDandField() override;
+
+    G4LogicalVolume* GetScoringVolume() const { return fScoringVolume; }
+
+    // Geometry variants, used at the next (re)construction
+    void SetStackFile(const G4String& stackFile) { fStackFile = stackFile; }
+    void SetOverrides(const std::vector<G4String>& overrides) { fOverrides = overrides; }
+    void SetCheckOverlaps(G4bool check) { fCheckOverlaps = check; }
+    // exampleB1 -b crosssection; before /run/initialize
+    void EnableCrossSectionBiasing() { fCrossSectionBiasing = true; }
+    G4bool IsCrossSectionBiasingEnabled() const { return fCrossSectionBiasing; }
+    // exampleB1 -b forcedcollision; before /run/initialize
+    void EnableForcedCollision() { fForcedCollision = true; }
+    // Registry name of a forced-collision volume, a trailing '*' matches a
+    // prefix; without any, the first wall slabs are forced
+    void AddForcedCollisionVolume(const G4String& pattern)
+    {
+      fForcedCollisionVolumes.push_back(pattern);
+    }
+    const G4String& GetStackFile() const { return fStackFile; }
+
+    // Before a geometry rebuild, while the old volumes still exist: the
+    // regions and the biasing cells let go of them
+    void ReleaseGeometry();
+
+    // Stack file of a blanket concept, e.g. WCLL -> wcll.stack
+    static G4String GetConceptStackFile(const G4String& concept);
+
+    // Filled by Construct(); shared read-only by all threads afterwards
+    const VolumeRegistry& GetVolumeRegistry() const { return fVolumes; }
+
+  protected:
+    G4LogicalVolume* fScoringVolume = nullptr;
+    VolumeRegistry fVolumes;
+
+  private:
+    // Places the layers front to back from z = front in the mother volume,
+    // whose centre is at global z = motherZ; appends the IDs of the scored
+    // slabs to fSlabIDs
+    void PlaceLayers(const LayerStack& stack, const std::vector<LayerStack::Layer>& layers,
+                     G4LogicalVolume* mother, G4double front, G4double motherZ);
+
+    void AddTransitions(G4int envelopeID);
+    void MarkForcedCollisionVolumes();
+
+    G4String fStackFile;
+    std::vector<G4String> fOverrides;  // LayerStack directives
+    std::vector<G4int> fSlabIDs;  // scored slabs, front to back
+    BlanketRegions fRegions;
+    G4bool fCheckOverlaps = true;
+    G4bool fCrossSectionBiasing = false;
+    G4bool fForcedCollision = false;
+    std::vector<G4String> fForcedCollisionVolumes;
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,86 @@
+/// \file B1/include/EnergyBinning.hh
+/// \brief Definition of the B1::EnergyBinning class
+
+#ifndef B1EnergyBinning_h
+#define B1EnergyBinning_h 1
+
+#include "globals.hh"
+
+#include <cmath>
+#include <vector>
+
+namespace B1
+{
+
+/// Energy bin edges with a fast bin lookup.
+///
+/// Uniform linear or logarithmic bins are found in O(1). Group
+/// structures, built in (VITAMIN-J 175) or loaded from a file of group
+/// boundaries (e.g. CCFE-709), use a binary search with a fixed number of
+/// iterations and no data-dependent branches.
+
+class EnergyBinning
+{
+  public:
+    enum Scale
+    {
+      kLinear,
+      kLogarithmic,
+      kGroups
+    };
+
+    EnergyBinning() = default;
+    EnergyBinning(Scale scale, G4int nBins, G4double eMin, G4double eMax);
+    // Group structure from boundaries in any order, in Geant4 energy units
+    EnergyBinning(std::vector<G4double> edges, const G4String& name = "groups");
+
+    // One boundary per line or whitespace-separated, '#' starts a comment;
+    // values are multiplied by unit
+    static EnergyBinning FromFile(const G4String& fileName, G4double unit);
+    // Built-in group structure, by one of the GetStandardNames()
+    static EnergyBinning FromName(const G4String& name);
+    static const char* GetStandardNames() { return "VITAMIN-J-175"; }
+
+    // Bin index, or -1 outside [eMin, eMax)
+    G4int FindBin(G4double energy) const
+    {
+      if (fScale == kGroups) return FindGroup(energy);
+      G4double x = (fScale == kLinear) ? energy : std::log(energy);
+      G4double bin = (x - fLow) * fInverseWidth;
+      return (bin >= 0. && bin < fNBins) ? static_cast<G4int>(bin) : -1;
+    }
+
+    G4int GetNumberOfBins() const { return fNBins; }
+    Scale GetScale() const { return fScale; }
+    const std::vector<G4double>& GetEdges() const { return fEdges; }
+    // Lethargy width ln(E_high / E_low), 0 for a bin starting at 0
+    G4double GetLethargyWidth(G4int bin) const;
+
+    // One-line summary for output file headers
+    G4String GetDescription() const;
+
+  private:
+    G4int FindGroup(G4double energy) const
+    {
+      // Largest i with fSearch[i] <= energy; fSearch is padded with
+      // +DBL_MAX to a power of two so every step stays in range
+      G4int base = 0;
+      for (G4int step = fSearchSize / 2; step > 0; step /= 2) {
+        base += (fSearch[base + step] <= energy) ? step : 0;
+      }
+      return (energy >= fSearch[0] && base < fNBins) ? base : -1;
+    }
+
+    Scale fScale = kLogarithmic;
+    G4String fName;
+    G4int fNBins = 0;
+    G4double fLow = 0.;
+    G4double fInverseWidth = 0.;
+    std::vector<G4double> fEdges;  // fNBins + 1, in Geant4 energy units
+    std::vector<G4double> fSearch;
+    G4int fSearchSize = 0;
+};
+
+}  // namespace B1
+
+#endif
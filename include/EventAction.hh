@@ -0,0 +1,100 @@
+#ifndef B1EventAction_h
+#define B1EventAction_h 1
+
+#include "G4UserEventAction.hh"
+#include "globals.hh"
+#include <vector>
+#include <G4String.hh>
+
+class G4Event;
+
+namespace B1
+{
+
+class RunAction;
+class VolumeRegistry;
+
+class EventAction : public G4UserEventAction
+{
+  public:
+    EventAction(RunAction* runAction, const VolumeRegistry* volumes);
+    ~EventAction() override = default;
+
+    void BeginOfEventAction(const G4Event* event) override;
+    void EndOfEventAction(const G4Event* event) override;
+
+    void AddEdep(G4double edep) { fEdep += edep; }
+
+    // Indexed by VolumeRegistry ID
+    void AddEdepByVolume(G4int volumeID, G4double edep) {
+      fEdepByVolume[volumeID] += edep;
+    }
+    const std::vector<G4double>& GetEdepByVolume() const {
+      return fEdepByVolume;
+    }
+
+    // Step counts for the per-region report, indexed by
+    // zone * RunAction::kNumberOfStepClasses + step class
+    void CountStep(G4int index) { ++fRegionSteps[index]; }
+
+    // Neutron cutoffs by zone: a killed neutron with its weight, or a
+    // roulette survivor with the weight it gained. The later steps of a
+    // survivor count for the zone where it was played: AddCutoffSurvivor
+    // returns the index the track keeps for CountCutoffSurvivorStep
+    void AddCutoffKill(G4int zone, G4double weight);
+    G4int AddCutoffSurvivor(G4int zone, G4double addedWeight);
+    void CountCutoffSurvivorStep(G4int index) { ++fCutoffScores[index]; }
+
+    // Neutron crossing energies, binned directly into the run spectra
+    void AddEnergyBeforeW(G4double energy, G4double weight);
+    void AddEnergyAfterW(G4double energy, G4double weight);
+    void AddEnergyBeforeEUROFER(G4double energy, G4double weight);
+    void AddEnergyAfterEUROFER(G4double energy, G4double weight);
+
+    // Produced nuclei, counted with their statistical weight
+    void AddTritium(G4double weight) { fTritiumCount += weight; }
+    // Expected (n,t) reactions along a neutron step, by layer index
+    void AddTrackLengthTritium(G4int layer, G4double reactions) {
+      fTritiumByLayer[layer] += reactions;
+    }
+    G4double GetTritiumCount() const { return fTritiumCount; }
+
+    void AddHelium(G4double weight) { fHeliumCount += weight; }
+    G4double GetHeliumCount() const { return fHeliumCount; }
+
+    // Extra neutrons of (n,xn) reactions, (x - 1) times their weight
+    void AddMultiplication(G4double weight) { fMultiplicationCount += weight; }
+
+    // Neutron backscatter handling
+    void MarkBackscattered() { fBackscattered = true; }
+    bool IsBackscattered() const { return fBackscattered; }
+
+    // Optional tracking: neutrons entering the first wall
+    void IncrementNeutronInCount() { ++fNeutronInCount; }
+
+    // Effective neutron: entered the first slab behind the first wall,
+    // once per track, with its weight at the crossing
+    void AddEffectiveNeutron(G4double weight) { fEffectiveNeutrons += weight; }
+
+  private:
+    RunAction* fRunAction = nullptr;
+    const VolumeRegistry* fVolumes = nullptr;
+    G4double fEdep = 0.;
+    std::vector<G4double> fEdepByVolume;
+    std::vector<G4double> fTritiumByLayer;
+    std::vector<G4double> fRegionSteps;
+    std::vector<G4double> fCutoffScores;
+
+    G4double fTritiumCount = 0.;
+    G4double fHeliumCount = 0.;
+    G4double fMultiplicationCount = 0.;
+
+    int fNeutronInCount = 0;       // (optional) Neutrons entering the first wall
+    bool fBackscattered = false;   // Neutron returned to Envelope from the first wall
+
+    G4double fEffectiveNeutrons = 0.;  // weighted, first entry of each track
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,136 @@
+/// \file B1/include/ImportanceGeometry.hh
+/// \brief Definition of the B1::ImportanceGeometry and B1::ImportanceMessenger classes
+
+#ifndef B1ImportanceGeometry_h
+#define B1ImportanceGeometry_h 1
+
+#include "WeightWindowMesh.hh"
+
+#include "G4UImessenger.hh"
+#include "G4VUserParallelWorld.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4VPhysicalVolume;
+class G4UIdirectory;
+class G4UIcmdWithADouble;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIcommand;
+
+namespace B1
+{
+
+class ImportanceMessenger;
+class VolumeRegistry;
+
+/// Parallel geometry of importance cells for neutron splitting and
+/// Russian roulette (G4ImportanceBiasing, exampleB1 -b importance), or of
+/// weight-window cells (G4WeightWindowBiasing, exampleB1 -b weightwindow).
+///
+/// The world is cut into slabs along z. The blanket behind the first wall,
+/// from the front face of the first layer after it to the back face of
+/// the last layer, is divided into nSlabs equal cells; the cell in front of
+/// it has importance 1, the cell behind it that of the last slab, so no
+/// roulette happens where the after-EUROFER current is scored. By default
+/// the importance doubles from slab to slab. The cells are rebuilt with
+/// the mass geometry, the importances can be changed between runs; after
+/// a release they wait for the new cells.
+///
+/// In weight-window mode each cell has a lower weight bound per energy
+/// group instead, read from a file that an earlier run generated from its
+/// mesh flux (WeightWindowMesh). Until a file is read every window is
+/// centred on weight 1, so the first run is an analog pilot. Either mode
+/// can generate the windows for the next run.
+
+class ImportanceGeometry : public G4VUserParallelWorld
+{
+  public:
+    enum Mode
+    {
+      kImportance,
+      kWeightWindow
+    };
+
+    ImportanceGeometry(const G4String& worldName, const VolumeRegistry* volumes,
+                       Mode mode = kImportance);
+    ~ImportanceGeometry() override;
+
+    void Construct() override;
+    // The cells are deleted with the mass geometry; until the next
+    // Construct() settings are kept and applied then
+    void ReleaseCells();
+
+    Mode GetMode() const { return fMode; }
+    G4VPhysicalVolume* GetWorldVolume() const { return fGhostWorld; }
+
+    // Cell boundaries along z, front to back, and the cell cross section;
+    // set by Construct()
+    const std::vector<G4double>& GetCellEdges() const { return fEdges; }
+    G4double GetCellArea() const { return fCellArea; }
+    G4int GetNumberOfCells() const { return static_cast<G4int>(fImportances.size()) + 2; }
+
+    // PreInit: number of slabs across the biased zone
+    void SetNumberOfSlabs(G4int nSlabs);
+    // Importance of slab i (from 0) is ratio^i
+    void SetRatio(G4double ratio);
+    void SetImportance(G4int slab, G4double importance);
+
+    // Logarithmic window groups from 1e-5 eV to 20 MeV; resets the windows
+    void SetWindowGroups(G4int nGroups);
+    const EnergyBinning& GetWindowGroups() const { return fWindows.groups; }
+    // Weight-window mode: windows of a file written by an earlier run
+    void ReadWindows(const G4String& fileName);
+    // Window file generated at the end of each run; empty for none
+    void SetWindowOutput(const G4String& fileName) { fWindowOutput = fileName; }
+    const G4String& GetWindowOutput() const { return fWindowOutput; }
+
+  private:
+    // Writes the importances or windows of the current cells into the
+    // G4IStore or G4WeightWindowStore
+    void FillStore() const;
+
+    const VolumeRegistry* fVolumes = nullptr;
+    Mode fMode = kImportance;
+    std::vector<G4double> fImportances;  // per slab
+    WeightWindowMesh::Windows fWindows;   // per cell and group
+    G4String fWindowOutput;
+
+    std::vector<G4double> fEdges;
+    G4double fCellArea = 0.;
+
+    G4VPhysicalVolume* fGhostWorld = nullptr;
+    std::vector<G4VPhysicalVolume*> fCells;  // front, slabs, back; copy number = index
+
+    ImportanceMessenger* fMessenger = nullptr;
+};
+
+/// /B1/importance/ and /B1/ww/ commands; master only, the importance and
+/// weight-window stores are shared
+
+class ImportanceMessenger : public G4UImessenger
+{
+  public:
+    ImportanceMessenger(ImportanceGeometry* geometry);
+    ~ImportanceMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    ImportanceGeometry* fGeometry = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcmdWithAnInteger* fNSlabsCmd = nullptr;
+    G4UIcmdWithADouble* fRatioCmd = nullptr;
+    G4UIcommand* fSetCmd = nullptr;
+
+    G4UIdirectory* fWindowDirectory = nullptr;
+    G4UIcmdWithAnInteger* fGroupsCmd = nullptr;
+    G4UIcmdWithAString* fReadCmd = nullptr;
+    G4UIcmdWithAString* fGenerateCmd = nullptr;
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,120 @@
+/// \file B1/include/LayerStack.hh
+/// \brief Definition of the B1::LayerStack class
+
+#ifndef B1LayerStack_h
+#define B1LayerStack_h 1
+
+#include "G4Colour.hh"
+#include "VolumeRegistry.hh"
+#include "globals.hh"
+
+#include <utility>
+#include <vector>
+
+class G4Material;
+
+namespace B1
+{
+
+/// Blanket geometry description read from a text file: a stack of slabs
+/// along z, front to back, inside a box envelope.
+///
+/// One directive per line, '#' starts a comment, lengths and densities are
+/// a number followed by a Geant4 unit:
+///
+///   world     <material> <margin>              world = margin x envelope
+///   envelope  <material> <xy> <unit> <z> <unit>
+///   layer_xy  <xy> <unit>                      transverse size of the slabs
+///   front_z   <z> <unit>                       front face of the first slab
+///   depth_origin <z> <unit>                    depth profile reference,
+///                                              front_z by default
+///   source_z  <z> <unit>                       plane of the neutron source,
+///                                              envelope front by default
+///   material  <name> <density> <unit> mass|atoms <element> <amount> ...
+///             [enrich=<Li-6 at.%>]
+///   layer     <name> <kind> <material> <thickness> <unit>
+///             [seg=<n>] [enrich=<Li-6 at.%>] [colour=r,g,b,a]
+///   container <name> <material> [colour=r,g,b,a]
+///     layer ...                                placed inside, front to back
+///   end
+///   thickness <layer> <t> <unit>               overrides, applied after all
+///   enrich    <layer|material> <Li-6 at.%>     layers are read
+///
+/// Kinds are firstwall, multiplier, breeder, backplate and structure.
+/// Materials not defined in the file are taken from the NIST database.
+/// A layer enrich= option builds a variant of its material with that Li-6
+/// fraction, and seg=n splits a layer into n scored slabs <name>_1..n.
+/// Override names may end in '*' to match a prefix (e.g. Be*); enrich also
+/// applies to every layer made of a matching material. Containers grow or
+/// shrink with their contents.
+
+class LayerStack
+{
+  public:
+    struct Material
+    {
+      G4String name;
+      G4double density = 0.;
+      G4bool byMass = true;
+      std::vector<std::pair<G4String, G4double>> components;  // symbol, amount
+      G4double enrichment = -1.;  // Li-6 atom fraction, < 0 for natural Li
+    };
+
+    struct Layer
+    {
+      G4String name;
+      VolumeRegistry::VolumeKind kind = VolumeRegistry::kStructure;
+      G4String material;
+      G4double thickness = 0.;  // sum of the contents for a container
+      G4int segments = 1;
+      G4double enrichment = -1.;  // overrides the material's when >= 0
+      G4bool hasColour = false;
+      G4Colour colour;
+      std::vector<Layer> layers;  // contents of a container
+    };
+
+    // Overrides are extra directive lines, read after the file
+    static LayerStack Read(const G4String& fileName,
+                           const std::vector<G4String>& overrides = {});
+
+    // NIST or file-defined material, built on first use; enrichment >= 0
+    // gives a variant with that Li-6 atom fraction
+    G4Material* GetMaterial(const G4String& name, G4double enrichment = -1.) const;
+
+    const G4String& GetFileName() const { return fFileName; }
+    const G4String& GetWorldMaterial() const { return fWorldMaterial; }
+    G4double GetWorldMargin() const { return fWorldMargin; }
+    const G4String& GetEnvelopeMaterial() const { return fEnvelopeMaterial; }
+    G4double GetEnvelopeXY() const { return fEnvelopeXY; }
+    G4double GetEnvelopeZ() const { return fEnvelopeZ; }
+    G4double GetLayerXY() const { return fLayerXY; }
+    G4double GetFrontZ() const { return fFrontZ; }
+    G4double GetDepthOrigin() const { return fDepthOrigin; }
+    G4double GetSourceZ() const { return fSourceZ; }
+    G4double GetThickness() const;
+    const std::vector<Layer>& GetLayers() const { return fLayers; }
+
+  private:
+    LayerStack() = default;
+
+    void Check() const;
+
+    G4String fFileName;
+    G4String fWorldMaterial = "G4_Galactic";
+    G4double fWorldMargin = 1.2;
+    G4String fEnvelopeMaterial = "G4_Galactic";
+    G4double fEnvelopeXY = 0.;
+    G4double fEnvelopeZ = 0.;
+    G4double fLayerXY = 0.;
+    G4double fFrontZ = 0.;
+    G4double fDepthOrigin = 0.;
+    G4bool fHasDepthOrigin = false;
+    G4double fSourceZ = 0.;
+    G4bool fHasSourceZ = false;
+    std::vector<Material> fMaterials;
+    std::vector<Layer> fLayers;
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,70 @@
+/// \file B1/include/LocalDeposition.hh
+/// \brief Definition of the B1::LocalDepositionProcess and B1::LocalDepositionPhysics classes
+
+#ifndef B1LocalDeposition_h
+#define B1LocalDeposition_h 1
+
+#include "G4VDiscreteProcess.hh"
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+namespace B1
+{
+
+class VolumeRegistry;
+
+/// Stops a photon or electron below a kinetic energy threshold and deposits
+/// its energy on the spot, instead of transporting it to the end of its
+/// range. Positrons are left alone so that their annihilation photons
+/// still carry energy away. The threshold is capped at the lowest (gamma,n)
+/// threshold of the current geometry, so no photoneutron is lost.
+
+class LocalDepositionProcess : public G4VDiscreteProcess
+{
+  public:
+    LocalDepositionProcess(G4double threshold, const VolumeRegistry* volumes,
+                           const G4String& name = "localDeposition");
+    ~LocalDepositionProcess() override = default;
+
+    G4bool IsApplicable(const G4ParticleDefinition& particle) override;
+
+    G4double PostStepGetPhysicalInteractionLength(const G4Track& track, G4double previousStepSize,
+                                                  G4ForceCondition* condition) override;
+    G4VParticleChange* PostStepDoIt(const G4Track& track, const G4Step& step) override;
+
+  protected:
+    G4double GetMeanFreePath(const G4Track&, G4double, G4ForceCondition*) override
+    {
+      return DBL_MAX;
+    }
+
+  private:
+    G4double fThreshold;
+    const VolumeRegistry* fVolumes;
+};
+
+/// Adds LocalDepositionProcess to gammas and electrons; a threshold of
+/// zero (the default) leaves the particle fully transported
+
+class LocalDepositionPhysics : public G4VPhysicsConstructor
+{
+  public:
+    LocalDepositionPhysics(const VolumeRegistry* volumes);
+    ~LocalDepositionPhysics() override = default;
+
+    // PreInit only: applied when the processes are constructed
+    void SetGammaThreshold(G4double energy) { fGammaThreshold = energy; }
+    void SetElectronThreshold(G4double energy) { fElectronThreshold = energy; }
+
+    void ConstructParticle() override;
+    void ConstructProcess() override;
+
+  private:
+    const VolumeRegistry* fVolumes = nullptr;
+    G4double fGammaThreshold = 0.;
+    G4double fElectronThreshold = 0.;
+};
+
+}  // namespace B1
+
+#endif
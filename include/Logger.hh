@@ -0,0 +1,94 @@
+/// \file B1/include/Logger.hh
+/// \brief Definition of the B1::Logger class and the B1_LOG macro
+
+#ifndef B1Logger_h
+#define B1Logger_h 1
+
+#include "G4UImessenger.hh"
+#include "G4ios.hh"
+#include "globals.hh"
+
+#include <atomic>
+
+class G4UIdirectory;
+class G4UIcmdWithAnInteger;
+class G4UIcommand;
+
+namespace B1
+{
+
+/// Leveled, rate-limited diagnostic output.
+///
+/// Messages are written with B1_LOG(channel, level) << ... << G4endl.
+/// A message is printed when its level does not exceed the current
+/// verbosity, its channel is enabled and, in "first N" mode, fewer than
+/// N messages of that channel were printed by this thread in this run.
+/// Unless the build defines B1_DIAGNOSTICS the macro expands to a dead
+/// branch: the stream arguments are still type-checked, but the test and
+/// their evaluation are removed by the compiler, so expressions that only
+/// feed a message belong inside the stream expression.
+
+class Logger
+{
+  public:
+    enum Channel
+    {
+      kTriton,
+      kHelium,
+      kMultiplication,
+      kEvent,
+      kNumberOfChannels
+    };
+
+    enum Level
+    {
+      kQuiet = 0,
+      kEventSummary = 1,  // one line per event
+      kSecondary = 2      // one line per produced secondary
+    };
+
+    static G4bool ShouldLog(Channel channel, Level level);
+
+    static void SetLevel(G4int level) { fgLevel = level; }
+    static void SetFirstN(G4int n) { fgFirstN = n; }
+    static void SetChannel(Channel channel, G4bool enabled);
+
+    // Per-thread "first N" counters; called at the start of each run
+    static void ResetCounters();
+
+    static const char* GetChannelName(Channel channel);
+
+  private:
+    static std::atomic<G4int> fgLevel;
+    static std::atomic<G4int> fgFirstN;  // 0: unlimited
+    static std::atomic<unsigned> fgChannels;
+};
+
+/// /B1/log/ commands; instantiated once, on the master
+
+class LoggerMessenger : public G4UImessenger
+{
+  public:
+    LoggerMessenger();
+    ~LoggerMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcmdWithAnInteger* fLevelCmd = nullptr;
+    G4UIcmdWithAnInteger* fFirstNCmd = nullptr;
+    G4UIcommand* fChannelCmd = nullptr;
+};
+
+}  // namespace B1
+
+#ifdef B1_DIAGNOSTICS
+#define B1_LOG(channel, level) \
+  if (!B1::Logger::ShouldLog(B1::Logger::channel, B1::Logger::level)) {} else G4cout
+#else
+#define B1_LOG(channel, level) \
+  if (true) {} else G4cout
+#endif
+
+#endif
@@ -0,0 +1,125 @@
+/// \file B1/include/NeutronCutoffs.hh
+/// \brief Definition of the B1::NeutronCutoffs and B1::CutoffMessenger classes
+
+#ifndef B1NeutronCutoffs_h
+#define B1NeutronCutoffs_h 1
+
+#include "BlanketRegions.hh"
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+#include <cfloat>
+#include <ostream>
+
+class G4UIdirectory;
+class G4UIcommand;
+class G4UIcmdWithAString;
+class G4UIcmdWithADouble;
+
+namespace B1
+{
+
+class CutoffMessenger;
+
+/// Energy and time cutoffs for neutrons, per BlanketRegions zone.
+///
+/// A neutron is cut when it ends a step in a zone below the energy cut of
+/// that zone or later than its time cut; "World" stands for the world,
+/// the envelope and the containers. Thermalised neutrons in the back plate
+/// or the envelope then stop taking elastic steps that breed nothing.
+///
+///   kill      the neutron is killed, and its weight is lost
+///   roulette  it survives with probability p, its weight divided by p;
+///             expectation values are preserved
+///
+/// A neutron is played on the step that takes it into the cut domain; a
+/// survivor that leaves it (into a zone with other cuts) and comes back is
+/// played again. The survivors go on, and their steps measure what the
+/// killed neutrons would have cost. Cuts are meant for the zones where the
+/// TBR is not scored; in the breeder they bias it in either mode.
+
+class NeutronCutoffs
+{
+  public:
+    enum Mode
+    {
+      kKill,
+      kRoulette
+    };
+
+    NeutronCutoffs();
+    ~NeutronCutoffs();
+
+    // 0 removes the cut
+    void SetEnergyCut(G4int zone, G4double energy)
+    {
+      fEnergyCuts[zone] = energy;
+      UpdateActive();
+    }
+    void SetTimeCut(G4int zone, G4double time)
+    {
+      fTimeCuts[zone] = (time > 0.) ? time : DBL_MAX;
+      UpdateActive();
+    }
+    void SetMode(Mode mode) { fMode = mode; }
+    void SetSurvivalProbability(G4double probability) { fSurvival = probability; }
+
+    // Any cut set; kept up to date by the setters, read on every step
+    G4bool IsActive() const { return fActive; }
+
+    G4bool IsCut(G4int zone, G4double energy, G4double time) const
+    {
+      return energy < fEnergyCuts[zone] || time > fTimeCuts[zone];
+    }
+
+    Mode GetMode() const { return fMode; }
+    // 0 in kill mode
+    G4double GetSurvivalProbability() const { return (fMode == kRoulette) ? fSurvival : 0.; }
+
+    // Settings in force, one line for the run summary
+    void Print(std::ostream& out) const;
+
+  private:
+    void UpdateActive()
+    {
+      fActive = false;
+      for (G4int zone = 0; zone <= BlanketRegions::kNumberOfZones; ++zone) {
+        if (fEnergyCuts[zone] > 0. || fTimeCuts[zone] < DBL_MAX) fActive = true;
+      }
+    }
+
+    G4double fEnergyCuts[BlanketRegions::kNumberOfZones + 1] = {};
+    G4double fTimeCuts[BlanketRegions::kNumberOfZones + 1] = {DBL_MAX, DBL_MAX, DBL_MAX,
+                                                              DBL_MAX, DBL_MAX};
+    Mode fMode = kKill;
+    G4double fSurvival = 0.1;
+    G4bool fActive = false;
+
+    CutoffMessenger* fMessenger = nullptr;
+};
+
+/// /B1/cutoff/ commands; one instance per RunAction, so the cuts are
+/// broadcast to the workers and take effect at the next run
+
+class CutoffMessenger : public G4UImessenger
+{
+  public:
+    CutoffMessenger(NeutronCutoffs* cutoffs);
+    ~CutoffMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    NeutronCutoffs* fCutoffs = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcommand* fEnergyCmd = nullptr;
+    G4UIcommand* fTimeCmd = nullptr;
+    G4UIcmdWithAString* fModeCmd = nullptr;
+    G4UIcmdWithADouble* fSurvivalCmd = nullptr;
+};
+
+}  // namespace B1
+
+#endif
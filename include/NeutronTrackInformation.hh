@@ -0,0 +1,44 @@
+/// \file B1/include/NeutronTrackInformation.hh
+/// \brief Definition of the B1::NeutronTrackInformation class
+
+#ifndef B1NeutronTrackInformation_h
+#define B1NeutronTrackInformation_h 1
+
+#include "G4Track.hh"
+#include "G4VUserTrackInformation.hh"
+#include "globals.hh"
+
+namespace B1
+{
+
+/// Per-track flags of the stepping action, attached to a neutron the first
+/// time one is needed and deleted with the track. Split clones start
+/// without it.
+
+class NeutronTrackInformation : public G4VUserTrackInformation
+{
+  public:
+    NeutronTrackInformation() = default;
+    ~NeutronTrackInformation() override = default;
+
+    // The information of the track, attached on the first call
+    static NeutronTrackInformation* Get(G4Track* track)
+    {
+      auto info = static_cast<NeutronTrackInformation*>(track->GetUserInformation());
+      if (!info) {
+        info = new NeutronTrackInformation();
+        track->SetUserInformation(info);
+      }
+      return info;
+    }
+
+    // Entry behind the first wall already scored
+    G4bool effectiveCounted = false;
+    // Roulette survivor of a cutoff: index of the step count of the zone
+    // where it was last played, -1 otherwise
+    G4int cutoffStepIndex = -1;
+};
+
+}  // namespace B1
+
+#endif
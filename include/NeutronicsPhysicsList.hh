@@ -0,0 +1,83 @@
+/// \file B1/include/NeutronicsPhysicsList.hh
+/// \brief Definition of the B1::NeutronicsPhysicsList and B1::NeutronicsPhysicsMessenger classes
+
+#ifndef B1NeutronicsPhysicsList_h
+#define B1NeutronicsPhysicsList_h 1
+
+#include "G4UImessenger.hh"
+#include "G4VModularPhysicsList.hh"
+#include "globals.hh"
+
+class G4EmExtraPhysics;
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
+
+namespace B1
+{
+
+class LocalDepositionPhysics;
+class NeutronicsPhysicsMessenger;
+class VolumeRegistry;
+
+/// Modular physics list for blanket neutronics.
+///
+/// The hadronic part is that of QGSP_BIC_HP (ParticleHP below 20 MeV for
+/// neutron elastic, inelastic, capture and fission, Binary cascade above,
+/// G4NeutronTrackingCut at 10 us), and so are G4EmExtraPhysics and its
+/// (gamma,n) photoneutrons, e.g. from Be-9 above 1.67 MeV. Switching the
+/// photo- and electro-nuclear reactions off is faster but removes those
+/// neutrons, and with them part of the tritium production. The EM
+/// fidelity is selectable:
+///   fast      G4EmStandardPhysics_option1 (simple e- step limitation)
+///   standard  G4EmStandardPhysics, as in QGSP_BIC_HP
+///   accurate  G4EmStandardPhysics_option4
+/// Photons and electrons can in addition be stopped and deposited on the
+/// spot below per-particle thresholds (LocalDepositionPhysics), capped at
+/// the lowest (gamma,n) threshold of the geometry.
+
+class NeutronicsPhysicsList : public G4VModularPhysicsList
+{
+  public:
+    // volumes: the registry of the mass geometry, for the (gamma,n) threshold
+    NeutronicsPhysicsList(const VolumeRegistry* volumes);
+    ~NeutronicsPhysicsList() override;
+
+    // PreInit only
+    void SetEmOption(const G4String& option);
+    void SetGammaLocalDeposit(G4double energy);
+    void SetElectronLocalDeposit(G4double energy);
+    void SetPhotoNuclear(G4bool enable);
+
+  private:
+    G4String fEmOption = "standard";
+    G4EmExtraPhysics* fEmExtra = nullptr;
+    LocalDepositionPhysics* fLocalDeposition = nullptr;
+    NeutronicsPhysicsMessenger* fMessenger = nullptr;
+};
+
+/// /B1/physics/ commands; master only, the workers copy the physics list
+/// as it was at /run/initialize
+
+class NeutronicsPhysicsMessenger : public G4UImessenger
+{
+  public:
+    NeutronicsPhysicsMessenger(NeutronicsPhysicsList* physicsList);
+    ~NeutronicsPhysicsMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    NeutronicsPhysicsList* fPhysicsList = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcmdWithAString* fEmCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fGammaLocalCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fElectronLocalCmd = nullptr;
+    G4UIcmdWithABool* fPhotoNuclearCmd = nullptr;
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,51 @@
+/// \file B1/include/OutputSink.hh
+/// \brief Definition of the B1::OutputSink class
+
+#ifndef B1OutputSink_h
+#define B1OutputSink_h 1
+
+#include "globals.hh"
+
+#include <fstream>
+#include <vector>
+
+namespace B1
+{
+
+/// Block-buffered text output of one quantity, private to one thread.
+///
+/// Each thread writes to its own part file, opened once at the start of
+/// the run. At the end of the run the master concatenates all parts into
+/// a single <quantity>_run<N>.txt, so repeated runs never append to the
+/// output of a previous one.
+
+class OutputSink
+{
+  public:
+    explicit OutputSink(const G4String& quantity);
+    OutputSink(OutputSink&&) = default;
+    OutputSink& operator=(OutputSink&&) = default;
+    ~OutputSink();
+
+    void Open(G4int runID);
+    void Close();
+
+    G4bool IsOpen() const { return fFile.is_open(); }
+    std::ofstream& Stream() { return fFile; }
+
+    const G4String& GetQuantity() const { return fQuantity; }
+
+    // Master only, after all workers closed their parts
+    static void Consolidate(const G4String& quantity, G4int runID);
+
+  private:
+    static constexpr std::size_t kBufferSize = 1 << 20;
+
+    G4String fQuantity;
+    std::vector<char> fBuffer;
+    std::ofstream fFile;
+};
+
+}  // namespace B1
+
+#endif
@@ -8,20 +8,21 @@
 
 class G4ParticleGun;
 class G4Event;
-class G4Box;
 
 namespace B1
 {
 
+class VolumeRegistry;
+
 /// The primary generator action class with particle gun.
 ///
 /// Default: 14 MeV neutrons, Gaussian-distributed energy,
-/// launched randomly over 80% of the envelope front face.
+/// launched from a small square at the source plane of the layer stack.
 
 class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 {
   public:
-    PrimaryGeneratorAction();
+    PrimaryGeneratorAction(const VolumeRegistry* volumes);
     ~PrimaryGeneratorAction() override;
 
     void GeneratePrimaries(G4Event*) override;
@@ -30,7 +31,7 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
 
   private:
     G4ParticleGun* fParticleGun = nullptr;
-    G4Box* fEnvelopeBox = nullptr;
+    const VolumeRegistry* fVolumes = nullptr;
 };
 
 }  // namespace B1
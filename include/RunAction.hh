@@ -0,0 +1,248 @@
+#ifndef B1RunAction_h
+#define B1RunAction_h 1
+
+#include "G4UserRunAction.hh"
+#include "G4Accumulable.hh"
+#include "G4Timer.hh"
+#include "NeutronCutoffs.hh"
+#include "VolumeAccumulable.hh"
+#include "SpectrumAccumulable.hh"
+#include "SurfaceTallies.hh"
+#include "TritiumCrossSections.hh"
+#include "WeightWindowMesh.hh"
+#include "OutputSink.hh"
+#include "globals.hh"
+#include <fstream>
+#include <vector>
+#include <G4String.hh>
+
+class G4Run;
+
+namespace B1
+{
+
+class ImportanceGeometry;
+class RunMessenger;
+class VolumeRegistry;
+
+class RunAction : public G4UserRunAction
+{
+  public:
+    // Per-thread text outputs, consolidated by the master at end of run
+    enum SinkID
+    {
+      kTritonDepth,
+      kAlphaDepth,
+      kMultiplicationDepth,
+      kNumberOfSinks
+    };
+
+    // Neutron energy spectra at the layer interfaces
+    enum SpectrumID
+    {
+      kSpectrumBeforeW,
+      kSpectrumAfterW,
+      kSpectrumBeforeEUROFER,
+      kSpectrumAfterEUROFER,
+      kNumberOfSpectra
+    };
+
+    // Particle classes of the per-region step counts
+    enum StepClass
+    {
+      kNeutronSteps,
+      kGammaSteps,
+      kElectronSteps,  // e- and e+
+      kOtherSteps,
+      kNumberOfStepClasses
+    };
+
+    // Per-region scores of the neutron cutoffs
+    enum CutoffScore
+    {
+      kCutoffKilled,
+      kCutoffKilledWeight,
+      kCutoffSurvivors,
+      kCutoffAddedWeight,     // gained by the roulette survivors
+      kCutoffSurvivorSteps,   // taken by the survivors after the roulette
+      kNumberOfCutoffScores
+    };
+
+    // Master only: main results of the last run, for the parameter scan
+    struct Summary
+    {
+      G4int runID = -1;
+      G4int nofEvents = 0;
+      G4double wallTime = 0.;
+      G4double tbrAnalog = 0.;
+      G4double tbrAnalogError = 0.;  // relative
+      G4bool tbrTrackLengthValid = false;  // evaluated (n,t) data loaded
+      G4double tbrTrackLength = 0.;
+      G4double tbrTrackLengthError = 0.;
+      G4double effectiveNeutrons = 0.;
+      G4double helium = 0.;
+    };
+
+    // cells: the biasing cells of exampleB1 -b, null without biasing
+    RunAction(const VolumeRegistry* volumes, const ImportanceGeometry* cells = nullptr);
+    ~RunAction() override;
+
+    void BeginOfRunAction(const G4Run*) override;
+    void EndOfRunAction(const G4Run*) override;
+
+    void AddEdep(G4double edep);
+    // Weighted counts of produced nuclei
+    void AddTritium(G4double count);
+    void AddHelium(G4double count);
+    void AddMultiplication(G4double count);
+
+    void AddEdepByVolume(G4int volumeID, G4double edep);
+
+    // EM secondaries deposited on the spot by the stacking action
+    void AddStackingDeposit(G4int tracks, G4double energy)
+    {
+      fStackingTracks += tracks;
+      fStackingEdep += energy;
+    }
+
+    OutputSink& GetSink(SinkID id) { return fSinks[id]; }
+
+    void FillSpectrum(SpectrumID id, G4double energy, G4double weight)
+    {
+      fSpectra.Fill(id, energy, weight);
+      fBatchSums[fCurrentOffset + id] += weight;
+    }
+
+    // Boundary-crossing currents declared with /B1/surface/
+    SurfaceTallies& GetSurfaceTallies() { return fSurfaces; }
+    void AddSurfaceTally(const SurfaceTallies::Declaration& declaration)
+    {
+      fSurfaces.Add(declaration);
+    }
+    void ClearSurfaceTallies() { fSurfaces.Clear(); }
+    void SetSurfaceCosineBins(G4int nBins) { fSurfaces.SetCosineBins(nBins); }
+
+    // Neutron flux on the biasing cells, scored while /B1/ww/generate is set
+    WeightWindowMesh& GetWindowMesh() { return fWindowMesh; }
+
+    // Track-length estimator: path length per unit volume, in cm-2
+    void FillLayerFlux(G4int layer, G4double energy, G4double trackLength)
+    {
+      fLayerFlux.Fill(layer, energy, trackLength * fInverseLayerVolumes[layer]);
+    }
+
+    // Per-event tritium production: analog triton count and track-length
+    // estimate per layer
+    void AddTritiumEstimates(G4double analogCount, const std::vector<G4double>& trackLengthByLayer);
+    const TritiumCrossSections& GetTritiumCrossSections() const { return fTritiumXS; }
+    void LoadTritiumCrossSection(G4int massNumber, const G4String& fileName)
+    {
+      fTritiumXS.LoadIsotopeData(massNumber, fileName);
+    }
+
+    // Factors of -b crosssection by CrossSectionBiasing::Channel, passed to
+    // the operator of the thread at the start of each run
+    void SetCrossSectionFactor(G4int channel, G4double factor)
+    {
+      fCrossSectionFactors[channel] = factor;
+    }
+
+    // Steps of one event by region and step class, region-major
+    void AddRegionSteps(const std::vector<G4double>& counts);
+
+    // Energy and time cutoffs set with /B1/cutoff/, and their scores for
+    // one event by region and CutoffScore, region-major
+    const NeutronCutoffs& GetNeutronCutoffs() const { return fCutoffs; }
+    void AddCutoffScores(const std::vector<G4double>& scores);
+
+    // Closes the event for the spectra and the batch statistics; aborts
+    // the event loop once the convergence monitor requests a stop
+    void EndOfEvent();
+
+    // Spectrum binning, applied at the start of the next run
+    void SetSpectrumScale(EnergyBinning::Scale scale) { fSpectrumScale = scale; }
+    void SetSpectrumGroups(const EnergyBinning& groups)
+    {
+      fSpectrumGroups = groups;
+      fSpectrumScale = EnergyBinning::kGroups;
+    }
+    void SetSpectrumBins(G4int nBins) { fSpectrumBins = nBins; }
+    void SetSpectrumEMin(G4double eMin) { fSpectrumEMin = eMin; }
+    void SetSpectrumEMax(G4double eMax) { fSpectrumEMax = eMax; }
+    void SetSpectrumBatchSize(G4int events) { fSpectrumBatchSize = events; }
+
+    const Summary& GetSummary() const { return fSummary; }
+
+    // Weighted neutrons entering the blanket behind the first wall, each
+    // track counted once
+    void AddEffectiveNeutrons(G4double weight) { fEffectiveNeutrons += weight; }
+
+  private:
+    G4Accumulable<G4double> fEdep = 0.;
+    G4Accumulable<G4double> fEdep2 = 0.;
+    G4Accumulable<G4double> fTritiumTotal = 0.;
+    G4Accumulable<G4double> fHeliumTotal = 0.;
+    G4Accumulable<G4double> fMultiplicationTotal = 0.;
+    G4Accumulable<G4double> fEffectiveNeutrons = 0.;
+    G4Accumulable<G4double> fStackingTracks = 0.;
+    G4Accumulable<G4double> fStackingEdep = 0.;
+
+    // Per-event layer deposits: sums and sums of squares, merged by index
+    VolumeAccumulable fLayerEdeps{"LayerEdeps"};
+    const VolumeRegistry* fVolumes = nullptr;
+
+    // Steps per event by BlanketRegions zone and StepClass
+    VolumeAccumulable fRegionSteps{"RegionSteps"};
+
+    // Neutron cutoffs; the steps per cut neutron of the last roulette run
+    // stand in for the kill runs that follow it (master only)
+    NeutronCutoffs fCutoffs;
+    VolumeAccumulable fCutoffScores{"NeutronCutoffs"};
+    std::vector<G4double> fStepsPerCutNeutron;
+
+    // Kept here rather than by the operator, which the master lacks
+    G4double fCrossSectionFactors[2] = {1., 1.};
+
+    // Crossing counts per energy bin, merged by index
+    SpectrumAccumulable fSpectra{"NeutronSpectra"};
+    EnergyBinning::Scale fSpectrumScale = EnergyBinning::kLogarithmic;
+    G4int fSpectrumBins = 200;
+    G4double fSpectrumEMin;
+    G4double fSpectrumEMax;
+    EnergyBinning fSpectrumGroups;  // used when fSpectrumScale is kGroups
+    G4int fSpectrumBatchSize = 1;
+
+    // Track-length flux per blanket layer, same binning as the spectra
+    SpectrumAccumulable fLayerFlux{"LayerFlux"};
+    std::vector<G4double> fInverseLayerVolumes;  // cm3 / volume
+
+    // Surface currents, same energy binning as the spectra
+    SurfaceTallies fSurfaces;
+
+    // Flux for the next weight-window file, on the cells and window groups
+    const ImportanceGeometry* fCells = nullptr;
+    WeightWindowMesh fWindowMesh;
+
+    // Tritium production per event: analog, track-length total, then
+    // track-length per layer
+    VolumeAccumulable fTritiumProduction{"TritiumProduction"};
+    TritiumCrossSections fTritiumXS;
+
+    // Per-event scores summed over the current batch, in the order of the
+    // ConvergenceMonitor quantities: TBR, layer deposits, interface currents
+    std::vector<G4double> fBatchSums;
+    G4int fBatchEvents = 0;
+    G4int fEdepOffset = 0;
+    G4int fCurrentOffset = 0;
+
+    std::vector<OutputSink> fSinks;
+    RunMessenger* fMessenger = nullptr;
+
+    std::ofstream outputFile;
+    G4Timer fTimer;  // master only: event loop wall time
+    Summary fSummary;
+};
+
+}  // namespace B1
+
+#endif
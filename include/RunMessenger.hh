@@ -0,0 +1,66 @@
+/// \file B1/include/RunMessenger.hh
+/// \brief Definition of the B1::RunMessenger class
+
+#ifndef B1RunMessenger_h
+#define B1RunMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class G4UIdirectory;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAnInteger;
+class G4UIcmdWithAString;
+class G4UIcommand;
+
+namespace B1
+{
+
+class RunAction;
+
+/// /B1/spectrum/, /B1/surface/, /B1/tbr/, /B1/xs/ and /B1/run/ commands; one instance per RunAction, so the settings
+/// are broadcast to the workers and take effect at the next run
+
+class RunMessenger : public G4UImessenger
+{
+  public:
+    RunMessenger(RunAction* runAction);
+    ~RunMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    RunAction* fRunAction = nullptr;
+
+    G4UIdirectory* fSpectrumDirectory = nullptr;
+    G4UIcmdWithAString* fBinningCmd = nullptr;
+    G4UIcmdWithAnInteger* fNBinsCmd = nullptr;
+    G4UIcmdWithAnInteger* fBatchSizeCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fEMinCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fEMaxCmd = nullptr;
+    G4UIcmdWithAString* fGroupsCmd = nullptr;
+    G4UIcommand* fGroupFileCmd = nullptr;
+
+    G4UIdirectory* fSurfaceDirectory = nullptr;
+    G4UIcommand* fSurfaceAddCmd = nullptr;
+    G4UIcommand* fSurfaceClearCmd = nullptr;
+    G4UIcmdWithAnInteger* fSurfaceCosBinsCmd = nullptr;
+
+    G4UIdirectory* fTbrDirectory = nullptr;
+    G4UIcommand* fTritiumXSCmd = nullptr;
+
+    G4UIdirectory* fXSDirectory = nullptr;
+    G4UIcommand* fXSFactorCmd = nullptr;
+
+    // Convergence monitor; not broadcast, the monitor is shared
+    G4UIdirectory* fRunDirectory = nullptr;
+    G4UIcommand* fStopRelErrCmd = nullptr;
+    G4UIcommand* fDropDeferredRelErrCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* fMaxWallTimeCmd = nullptr;
+    G4UIcmdWithAnInteger* fRunBatchSizeCmd = nullptr;
+    G4UIcmdWithAnInteger* fMinBatchesCmd = nullptr;
+};
+
+}  // namespace B1
+
+#endif
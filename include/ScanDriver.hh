@@ -0,0 +1,98 @@
+/// \file B1/include/ScanDriver.hh
+/// \brief Definition of the B1::ScanDriver and B1::ScanMessenger classes
+
+#ifndef B1ScanDriver_h
+#define B1ScanDriver_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4UIdirectory;
+class G4UIcmdWithABool;
+class G4UIcmdWithAString;
+class G4UIcommand;
+
+namespace B1
+{
+
+class DetectorConstruction;
+class ScanMessenger;
+
+/// In-process parameter scan over geometry variants.
+///
+/// Each line of a scan file is one point: a label followed by LayerStack
+/// override directives separated by ';', '#' starts a comment:
+///
+///   li6_60   enrich Li2TiO3 60
+///   be_8cm   thickness Be* 8 cm ; thickness Li2TiO3_* 8 cm
+///
+/// For every point only the geometry and materials are rebuilt; the
+/// physics list, its tables and the ParticleHP data loaded before the
+/// first point are kept. One result row per point is written to the scan
+/// output file. The nominal geometry is restored after the scan.
+
+class ScanDriver
+{
+  public:
+    explicit ScanDriver(DetectorConstruction* detector);
+    ~ScanDriver();
+
+    // Master, in the Idle state
+    void Run(const G4String& scanFile, G4int nofEvents);
+
+    // Replaces the layer stack file; rebuilt at the next run
+    void SetStackFile(const G4String& stackFile);
+
+    // exampleB1 -b forcedcollision: a volume to force, before /run/initialize
+    void AddForcedCollisionVolume(const G4String& pattern);
+
+    void SetOutputFile(const G4String& fileName) { fOutputFile = fileName; }
+    void SetCheckOverlaps(G4bool check) { fCheckOverlaps = check; }
+
+  private:
+    struct Point
+    {
+      G4String label;
+      std::vector<G4String> overrides;
+    };
+
+    std::vector<Point> ReadPoints(const G4String& fileName) const;
+
+    // Geometry and materials only; the physics is not touched
+    void RebuildGeometry(const std::vector<G4String>& overrides);
+
+    DetectorConstruction* fDetector = nullptr;
+    G4String fOutputFile = "scan_results.txt";
+    G4bool fCheckOverlaps = false;  // the nominal geometry is checked at /run/initialize
+    ScanMessenger* fMessenger = nullptr;
+};
+
+/// /B1/geometry/ and /B1/scan/ commands; instantiated once, on the master
+
+class ScanMessenger : public G4UImessenger
+{
+  public:
+    ScanMessenger(ScanDriver* driver);
+    ~ScanMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    ScanDriver* fDriver = nullptr;
+
+    G4UIdirectory* fGeometryDirectory = nullptr;
+    G4UIcmdWithAString* fStackFileCmd = nullptr;
+    G4UIcmdWithAString* fConceptCmd = nullptr;
+    G4UIcmdWithAString* fForceCollisionCmd = nullptr;
+
+    G4UIdirectory* fScanDirectory = nullptr;
+    G4UIcommand* fRunCmd = nullptr;
+    G4UIcmdWithAString* fOutputCmd = nullptr;
+    G4UIcmdWithABool* fCheckOverlapsCmd = nullptr;
+};
+
+}  // namespace B1
+
+#endif
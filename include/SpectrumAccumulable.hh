@@ -0,0 +1,101 @@
+/// \file B1/include/SpectrumAccumulable.hh
+/// \brief Definition of the B1::SpectrumAccumulable class
+
+#ifndef B1SpectrumAccumulable_h
+#define B1SpectrumAccumulable_h 1
+
+#include "EnergyBinning.hh"
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1
+{
+
+/// Set of energy spectra sharing one binning, kept as a dense
+/// (spectrum x bin) array per thread and merged element-wise.
+///
+/// Fills are collected over a batch of events and folded into per-bin
+/// sums and sums of squares when the batch is complete, so every bin
+/// carries its own statistical error over independent batches. The
+/// default batch size of one event gives the usual per-event variance.
+/// The partial last batch of each thread is folded as well; every batch
+/// enters the error with its number of events, so short batches do not
+/// count as full ones.
+
+class SpectrumAccumulable : public G4VAccumulable
+{
+  public:
+    SpectrumAccumulable(const G4String& name = "");
+    ~SpectrumAccumulable() override = default;
+
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+    void Print(G4PrintOptions options = G4PrintOptions()) const override;
+
+    // Must be called with identical arguments on all threads
+    void Configure(const std::vector<G4String>& labels, const EnergyBinning& binning);
+
+    void Fill(G4int spectrum, G4double energy, G4double weight = 1.)
+    {
+      G4int bin = fBinning.FindBin(energy);
+      if (bin < 0) return;
+      G4int index = spectrum * fBinning.GetNumberOfBins() + bin;
+      if (fBatch[index] == 0.) fTouched.push_back(index);
+      fBatch[index] += weight;
+    }
+
+    void SetBatchSize(G4int events) { fBatchSize = events; }
+    void EndOfEvent()
+    {
+      if (++fEventsInBatch >= fBatchSize) FoldBatch();
+    }
+    // Folds a partial last batch; call before merging at end of run
+    void Flush()
+    {
+      if (fEventsInBatch > 0) FoldBatch();
+    }
+    G4int GetNumberOfBatches() const { return fNBatches; }
+
+    G4int GetNumberOfSpectra() const { return static_cast<G4int>(fLabels.size()); }
+    const G4String& GetLabel(G4int spectrum) const { return fLabels[spectrum]; }
+    const EnergyBinning& GetBinning() const { return fBinning; }
+    G4double GetSum(G4int spectrum, G4int bin) const
+    {
+      return fSum[spectrum * fBinning.GetNumberOfBins() + bin];
+    }
+    G4double GetSum2(G4int spectrum, G4int bin) const
+    {
+      return fSum2[spectrum * fBinning.GetNumberOfBins() + bin];
+    }
+    // Relative error of the mean per event, over batches of any size
+    G4double GetRelativeError(G4int spectrum, G4int bin) const;
+
+    // Columns: bin edges in MeV, then per spectrum the mean per event,
+    // its relative error and the mean per unit lethargy
+    void Write(const G4String& fileName, const G4String& header, G4int nofEvents) const;
+
+  private:
+    void FoldBatch();
+
+    std::vector<G4String> fLabels;
+    EnergyBinning fBinning;
+    std::vector<G4double> fSum;
+    std::vector<G4double> fSum2;
+    std::vector<G4double> fSumN;  // batch sums times batch events
+    G4int fNBatches = 0;
+    G4double fNEvents = 0.;       // over all batches
+    G4double fNEvents2 = 0.;      // sum of squared batch events
+
+    // Current batch, not merged
+    G4int fBatchSize = 1;
+    G4int fEventsInBatch = 0;
+    std::vector<G4double> fBatch;
+    std::vector<G4int> fTouched;
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,107 @@
+/// \file B1/include/StackingAction.hh
+/// \brief Definition of the B1::StackingAction and B1::StackingMessenger classes
+
+#ifndef B1StackingAction_h
+#define B1StackingAction_h 1
+
+#include "G4UImessenger.hh"
+#include "G4UserStackingAction.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4ParticleDefinition;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+
+namespace B1
+{
+
+class EventAction;
+class RunAction;
+class StackingMessenger;
+class VolumeRegistry;
+
+/// Neutronics-only transport of the EM secondaries (gammas, e-, e+).
+///
+///   full   every track is transported (default)
+///   kill   EM secondaries are killed at birth; their energy, with the
+///          rest energy of positrons, is deposited in the volume where
+///          they were created
+///   defer  EM secondaries wait until the neutron cascade of the event is
+///          finished; they are then transported, or, once the drop rule of
+///          the ConvergenceMonitor (/B1/run/dropDeferredRelErr) has been
+///          met, deposited on the spot as in kill mode
+///
+/// Photons and electrons above the lowest (gamma,n) threshold of the
+/// materials present (VolumeRegistry::GetPhotoNeutronThreshold, 1.67 MeV
+/// with beryllium) are always transported, since their photoneutrons add
+/// to the TBR. The neutron-driven tallies (TBR, spectra, multiplication)
+/// are then unbiased in every mode; only the spatial distribution of the
+/// heating changes. The energy deposited this way is reported in the run
+/// summary.
+
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    enum Mode
+    {
+      kFull,
+      kKill,
+      kDefer
+    };
+
+    StackingAction(EventAction* eventAction, RunAction* runAction, const VolumeRegistry* volumes);
+    ~StackingAction() override;
+
+    G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track* track) override;
+    void NewStage() override;
+    void PrepareNewEvent() override;
+
+    void SetMode(Mode mode) { fMode = mode; }
+
+  private:
+    // Local deposition of a secondary that is not transported; returns
+    // the energy deposited
+    G4double Deposit(const G4Track* track);
+
+    EventAction* fEventAction = nullptr;
+    RunAction* fRunAction = nullptr;
+    const VolumeRegistry* fVolumes = nullptr;
+    Mode fMode = kFull;
+
+    // Event being processed: deferred energy by registry ID, deposited
+    // only if the waiting stack is dropped
+    G4int fStage = 0;
+    std::vector<G4double> fDeferredEnergy;
+    G4int fDeferredTracks = 0;
+
+    const G4ParticleDefinition* fGamma;
+    const G4ParticleDefinition* fElectron;
+    const G4ParticleDefinition* fPositron;
+
+    StackingMessenger* fMessenger = nullptr;
+};
+
+/// /B1/stack/ commands; one instance per StackingAction, so the mode is
+/// broadcast to the workers. There is no master instance: in MT mode the
+/// commands exist once /run/initialize has started the workers.
+
+class StackingMessenger : public G4UImessenger
+{
+  public:
+    StackingMessenger(StackingAction* stackingAction);
+    ~StackingMessenger() override;
+
+    void SetNewValue(G4UIcommand* command, G4String newValue) override;
+
+  private:
+    StackingAction* fStackingAction = nullptr;
+
+    G4UIdirectory* fDirectory = nullptr;
+    G4UIcmdWithAString* fModeCmd = nullptr;
+};
+
+}  // namespace B1
+
+#endif
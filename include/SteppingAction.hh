@@ -0,0 +1,66 @@
+/// \file B1/include/SteppingAction.hh
+/// \brief Definition of the B1::SteppingAction class
+
+#ifndef SteppingAction_h
+#define SteppingAction_h
+
+#include "G4UserSteppingAction.hh"
+#include "G4SystemOfUnits.hh"
+
+class G4ParticleDefinition;
+
+namespace B1
+{
+
+class EventAction;
+class NeutronCutoffs;
+class RunAction;
+class OutputSink;
+class SurfaceTallies;
+class TritiumCrossSections;
+class VolumeRegistry;
+class WeightWindowMesh;
+
+/// Stepping action class
+///
+/// One implementation serves every blanket concept: the interface rules
+/// are the VolumeRegistry transition flags derived from the layer stack,
+/// looked up with one load per step, so no per-concept branches remain.
+
+class SteppingAction : public G4UserSteppingAction
+{
+  public:
+    SteppingAction(EventAction* eventAction, RunAction* runAction,
+                   const VolumeRegistry* volumes);
+    ~SteppingAction() override;
+
+    void UserSteppingAction(const G4Step* step) override;
+
+  private:
+    EventAction* fEventAction;
+    RunAction* fRunAction;
+    const VolumeRegistry* fVolumes;
+
+    // Thread-local outputs owned by the RunAction of this thread
+    OutputSink& fTritonSink;
+    OutputSink& fAlphaSink;
+    OutputSink& fMultiplicationSink;
+
+    // Rebuilt by the RunAction at the start of each run
+    const TritiumCrossSections& fTritiumXS;
+    SurfaceTallies& fSurfaces;
+    WeightWindowMesh& fWindowMesh;
+    const NeutronCutoffs& fCutoffs;
+
+    // Cached definitions: particles are classified by pointer identity
+    const G4ParticleDefinition* fNeutron;
+    const G4ParticleDefinition* fTriton;
+    const G4ParticleDefinition* fAlpha;
+    const G4ParticleDefinition* fGamma;
+    const G4ParticleDefinition* fElectron;
+    const G4ParticleDefinition* fPositron;
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,105 @@
+/// \file B1/include/SurfaceTallies.hh
+/// \brief Definition of the B1::SurfaceTallies class
+
+#ifndef B1SurfaceTallies_h
+#define B1SurfaceTallies_h 1
+
+#include "SpectrumAccumulable.hh"
+
+#include "globals.hh"
+
+#include <cmath>
+#include <vector>
+
+class G4ParticleDefinition;
+
+namespace B1
+{
+
+class VolumeRegistry;
+
+/// Boundary-crossing current tallies declared from macros.
+///
+/// A declaration names the volume a particle leaves and the volume it
+/// enters (registry names; a trailing '*' matches a prefix, '*' alone any
+/// volume), the particle ("all" for any) and the direction of flight
+/// along z. At the start of each run the declarations are resolved into a
+/// from-by-to table of tally lists, so a boundary step needs one lookup.
+/// Crossings are binned in energy, with the spectrum binning, and in the
+/// cosine to the z axis, and weighted with the track weight.
+
+class SurfaceTallies
+{
+  public:
+    enum Direction : G4int
+    {
+      kBoth = 0,
+      kForward = 1,   // towards +z
+      kBackward = -1
+    };
+
+    struct Declaration
+    {
+      G4String name;
+      G4String from;
+      G4String to;
+      G4String particle = "neutron";
+      Direction direction = kBoth;
+    };
+
+    SurfaceTallies();
+    ~SurfaceTallies() = default;
+
+    // Declarations take effect at the next Configure()
+    void Add(const Declaration& declaration);
+    void Clear() { fDeclarations.clear(); }
+    void SetCosineBins(G4int nBins) { fCosineBins = nBins; }
+
+    // Resolves the declarations; identical arguments on every thread
+    void Configure(const VolumeRegistry& volumes, const EnergyBinning& binning, G4int batchSize);
+
+    G4bool IsEmpty() const { return fTallies.empty(); }
+
+    // Tallies of a crossing from one registry ID into another
+    const std::vector<G4int>& Find(G4int from, G4int to) const
+    {
+      return fTable[from * fNVolumes + to];
+    }
+
+    void Score(G4int tally, const G4ParticleDefinition* particle, G4double energy,
+               G4double cosZ, G4double weight)
+    {
+      const Tally& t = fTallies[tally];
+      if (t.particle && t.particle != particle) return;
+      if (t.direction * cosZ < 0.) return;
+      G4int bin = static_cast<G4int>(std::abs(cosZ) * fCosineBins);
+      if (bin >= fCosineBins) bin = fCosineBins - 1;
+      fCurrents.Fill(tally * fCosineBins + bin, energy, weight);
+    }
+
+    SpectrumAccumulable& GetAccumulable() { return fCurrents; }
+    void EndOfEvent() { fCurrents.EndOfEvent(); }
+    void Flush() { fCurrents.Flush(); }
+
+    // Master, after the merge
+    void Write(const G4String& fileName, G4int runID, G4int nofEvents) const;
+
+  private:
+    struct Tally
+    {
+      const G4ParticleDefinition* particle = nullptr;  // any if null
+      G4int direction = kBoth;
+    };
+
+    std::vector<Declaration> fDeclarations;
+    G4int fCosineBins = 1;
+
+    std::vector<Tally> fTallies;              // per declaration
+    G4int fNVolumes = 0;
+    std::vector<std::vector<G4int>> fTable;  // fNVolumes x fNVolumes, row = from
+    SpectrumAccumulable fCurrents{"SurfaceCurrents"};
+};
+
+}  // namespace B1
+
+#endif
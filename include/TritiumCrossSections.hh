@@ -0,0 +1,78 @@
+/// \file B1/include/TritiumCrossSections.hh
+/// \brief Definition of the B1::TritiumCrossSections class
+
+#ifndef B1TritiumCrossSections_h
+#define B1TritiumCrossSections_h 1
+
+#include "globals.hh"
+
+#include <cmath>
+#include <vector>
+
+namespace B1
+{
+
+class VolumeRegistry;
+
+/// Macroscopic tritium-production cross sections of the blanket layers,
+/// cached on a fine logarithmic energy grid for the track-length TBR
+/// estimator.
+///
+/// The microscopic Li-6/Li-7 (n,t) data are read from files, e.g. ENDF/B
+/// MT 105 of Li-6 and MT 205 of Li-7. Geant4 has no (n,t) cross section of
+/// its own (the Li non-elastic one is biased high for fast neutrons), so
+/// without them the estimator is off and the tables stay empty.
+
+class TritiumCrossSections
+{
+  public:
+    TritiumCrossSections() = default;
+    ~TritiumCrossSections() = default;
+
+    // Two columns, E [MeV] and sigma [barn], '#' starts a comment
+    void LoadIsotopeData(G4int massNumber, const G4String& fileName);
+
+    // Per thread, at the start of a run
+    void Build(const VolumeRegistry& volumes);
+    // Evaluated data were loaded at the last Build(): the estimator runs
+    G4bool IsActive() const { return fActive; }
+
+    // Sigma_t in 1/length at the given energy; 0 outside breeder layers
+    G4double GetMacroscopic(G4int layer, G4double energy) const
+    {
+      const auto& table = fTables[layer];
+      if (table.empty()) return 0.;
+      G4double x = (std::log(energy) - fLogEMin) * fPointsPerLogUnit;
+      if (x <= 0.) return table.front();
+      if (x >= fNPoints - 1) return table.back();
+      auto i = static_cast<G4int>(x);
+      G4double f = x - i;
+      return table[i] + f * (table[i + 1] - table[i]);
+    }
+
+    G4bool IsBreeder(G4int layer) const { return !fTables[layer].empty(); }
+    // Evaluated (n,t) data loaded
+    G4bool IsTabulated() const { return !fLi6.energies.empty() || !fLi7.energies.empty(); }
+    G4String GetDescription() const;
+
+  private:
+    struct IsotopeData
+    {
+      std::vector<G4double> energies;  // ascending
+      std::vector<G4double> sigmas;
+    };
+    G4double GetIsotopeSigma(const IsotopeData& data, G4double energy) const;
+
+    IsotopeData fLi6;
+    IsotopeData fLi7;
+
+    G4double fLogEMin = 0.;
+    G4double fPointsPerLogUnit = 0.;
+    G4int fNPoints = 0;
+    G4bool fActive = false;
+    std::vector<std::vector<G4double>> fTables;  // per layer, empty if no Li
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,54 @@
+/// \file B1/include/VolumeAccumulable.hh
+/// \brief Definition of the B1::VolumeAccumulable class
+
+#ifndef B1VolumeAccumulable_h
+#define B1VolumeAccumulable_h 1
+
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+#include <vector>
+
+namespace B1
+{
+
+/// Accumulable of per-volume sums and sums of squares.
+///
+/// Entries are addressed by a dense index that is identical on every
+/// thread, so merging workers into the master is a plain element-wise
+/// addition of two arrays. The labels are only used for printing.
+
+class VolumeAccumulable : public G4VAccumulable
+{
+  public:
+    VolumeAccumulable(const G4String& name = "");
+    ~VolumeAccumulable() override = default;
+
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+    void Print(G4PrintOptions options = G4PrintOptions()) const override;
+
+    // Size the table; must be called with the same labels on all threads
+    void SetLabels(const std::vector<G4String>& labels);
+
+    // Add one independent sample (e.g. the total of one event)
+    void Fill(std::size_t index, G4double value)
+    {
+      fSum[index] += value;
+      fSum2[index] += value * value;
+    }
+
+    std::size_t GetSize() const { return fSum.size(); }
+    const G4String& GetLabel(std::size_t index) const { return fLabels[index]; }
+    G4double GetSum(std::size_t index) const { return fSum[index]; }
+    G4double GetSum2(std::size_t index) const { return fSum2[index]; }
+
+  private:
+    std::vector<G4String> fLabels;
+    std::vector<G4double> fSum;
+    std::vector<G4double> fSum2;
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,141 @@
+/// \file B1/include/VolumeRegistry.hh
+/// \brief Definition of the B1::VolumeRegistry class
+
+#ifndef B1VolumeRegistry_h
+#define B1VolumeRegistry_h 1
+
+#include "globals.hh"
+
+#include <cfloat>
+
+class G4LogicalVolume;
+class G4Material;
+
+#include <vector>
+
+namespace B1
+{
+
+/// Dense integer IDs for the scoring volumes, resolved once at geometry
+/// construction.
+///
+/// Every physical volume is placed with its registry ID as copy number,
+/// so the stepping action identifies volumes with GetCopyNo() alone.
+/// Interface crossings are looked up in a precomputed from-by-to matrix
+/// of Transition flags. Blanket layers additionally get a dense layer
+/// index, their cubic volume and material, for the track-length tallies.
+/// Masses are computed once, after the geometry is complete. Each volume
+/// carries its VolumeKind, the role it plays in the blanket.
+
+class VolumeRegistry
+{
+  public:
+    enum Transition : unsigned
+    {
+      kNone = 0,
+      kBeforeW = 1u << 0,        // neutron enters the first wall
+      kBackscatter = 1u << 1,    // neutron leaves the first wall backwards
+      kAfterW = 1u << 2,         // neutron leaves the first wall inwards
+      kEffective = 1u << 3,      // neutron reaches the blanket proper
+      kBeforeEUROFER = 1u << 4,  // neutron enters the back plate
+      kAfterEUROFER = 1u << 5    // neutron leaves the back plate
+    };
+
+    enum VolumeKind : G4int
+    {
+      kWorld,
+      kEnvelope,
+      kContainer,   // holds other layers, not scored itself
+      kFirstWall,
+      kMultiplier,
+      kBreeder,
+      kBackPlate,
+      kStructure
+    };
+
+    VolumeRegistry() = default;
+    ~VolumeRegistry() = default;
+
+    void Clear();
+
+    // Returns the ID to be used as copy number of the placement
+    G4int Register(const G4String& name, G4LogicalVolume* logical, VolumeKind kind);
+
+    // Mass and volume of every registered volume, daughters excluded, and
+    // the photoneutron threshold of their materials; call once all
+    // placements are done
+    void ComputeMasses();
+
+    // Set-up time lookup only; returns -1 for unknown names
+    G4int GetID(const G4String& name) const;
+
+    void AddTransition(G4int from, G4int to, unsigned flags);
+
+    unsigned GetTransition(G4int from, G4int to) const
+    {
+      return fTransitions[from * GetSize() + to];
+    }
+
+    // Marks a registered volume as a scored blanket layer, with the global
+    // z of its front and back faces
+    void SetLayer(G4int id, G4double frontZ, G4double backZ);
+
+    // Z of the reference plane for the tritium and alpha depth profiles
+    void SetDepthOrigin(G4double z) { fDepthOrigin = z; }
+    G4double GetDepthOrigin() const { return fDepthOrigin; }
+
+    // Neutron source plane: z and transverse width of the envelope
+    void SetSourcePlane(G4double z, G4double width)
+    {
+      fSourceZ = z;
+      fSourceWidth = width;
+    }
+    G4double GetSourceZ() const { return fSourceZ; }
+    G4double GetSourceWidth() const { return fSourceWidth; }
+
+    // Dense layer index, or -1 if the volume is not a layer
+    G4int GetLayerIndex(G4int id) const { return fLayerIndex[id]; }
+    G4int GetNumberOfLayers() const { return static_cast<G4int>(fLayerIDs.size()); }
+    G4int GetLayerID(G4int layer) const { return fLayerIDs[layer]; }
+    G4double GetLayerVolume(G4int layer) const { return fLayerVolumes[layer]; }
+    const G4Material* GetLayerMaterial(G4int layer) const { return fLayerMaterials[layer]; }
+    G4double GetLayerFrontZ(G4int layer) const { return fLayerFrontZ[layer]; }
+    G4double GetLayerBackZ(G4int layer) const { return fLayerBackZ[layer]; }
+
+    G4int GetSize() const { return static_cast<G4int>(fNames.size()); }
+    const G4String& GetName(G4int id) const { return fNames[id]; }
+    const std::vector<G4String>& GetNames() const { return fNames; }
+    VolumeKind GetKind(G4int id) const { return fKinds[id]; }
+    G4LogicalVolume* GetLogical(G4int id) const { return fLogicals[id]; }
+
+    // Thin volumes where every entering neutron is forced to collide
+    void SetForcedCollision(G4int id) { fForcedCollision[id] = true; }
+    G4bool IsForcedCollision(G4int id) const { return fForcedCollision[id]; }
+    G4double GetMass(G4int id) const { return fMasses[id]; }
+    // Lowest (gamma,n) threshold of the isotopes present, DBL_MAX if none
+    G4double GetPhotoNeutronThreshold() const { return fPhotoNeutronThreshold; }
+    G4double GetNetVolume(G4int id) const { return fNetVolumes[id]; }
+
+  private:
+    std::vector<G4String> fNames;
+    std::vector<G4LogicalVolume*> fLogicals;
+    std::vector<VolumeKind> fKinds;
+    std::vector<G4bool> fForcedCollision;
+    std::vector<G4double> fMasses;
+    std::vector<G4double> fNetVolumes;
+    std::vector<unsigned> fTransitions;  // GetSize() x GetSize(), row = from
+    std::vector<G4int> fLayerIndex;      // per registry ID
+    std::vector<G4int> fLayerIDs;        // per layer
+    std::vector<G4double> fLayerVolumes;  // per layer
+    std::vector<const G4Material*> fLayerMaterials;  // per layer
+    std::vector<G4double> fLayerFrontZ;  // per layer, global
+    std::vector<G4double> fLayerBackZ;
+    G4double fDepthOrigin = 0.;
+    G4double fSourceZ = 0.;
+    G4double fSourceWidth = 0.;
+    G4double fPhotoNeutronThreshold = DBL_MAX;
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,87 @@
+/// \file B1/include/WeightWindowMesh.hh
+/// \brief Definition of the B1::WeightWindowMesh class
+
+#ifndef B1WeightWindowMesh_h
+#define B1WeightWindowMesh_h 1
+
+#include "SpectrumAccumulable.hh"
+
+#include "globals.hh"
+
+#include <ostream>
+#include <vector>
+
+namespace B1
+{
+
+/// Neutron flux on the z-energy mesh of the biasing cells, and the weight
+/// windows derived from it.
+///
+/// The mesh cells are the z slabs of the ImportanceGeometry, the energy
+/// bins its window groups. A run that is to generate windows scores the
+/// track-length flux of every neutron step, split over the cells the step
+/// crosses. At the end of the run the lower weight bound of each cell and
+/// group is made proportional to its flux, with the brightest group of the
+/// front cell, where the source is, centred on weight 1. Particles then
+/// reach every cell and group in similar numbers, which evens out the
+/// relative errors. Windows are [w, 5 w] with survival weight 3 w.
+
+class WeightWindowMesh
+{
+  public:
+    // G4WeightWindowAlgorithm parameters of exampleB1 -b weightwindow
+    static constexpr G4double kUpperFactor = 5.;
+    static constexpr G4double kSurvivalFactor = 3.;
+    static constexpr G4int kMaxSplits = 5;
+
+    // Lower weight bounds, cell-major, with their group structure
+    struct Windows
+    {
+      EnergyBinning groups;
+      std::vector<G4double> lowerWeights;  // cells x groups
+    };
+
+    // Windows centred on weight 1 everywhere: an analog pilot run
+    static Windows MakeDefault(G4int nCells, const EnergyBinning& groups);
+
+    // Window file: group boundaries in MeV, then one row per cell with its
+    // z range in cm and the lower weights; false if it does not match nCells
+    static G4bool Read(const G4String& fileName, G4int nCells, Windows& windows);
+
+    WeightWindowMesh();
+    ~WeightWindowMesh() = default;
+
+    // Cell boundaries along z and the cell cross section; empty edges
+    // switch the scoring off. Identical arguments on every thread.
+    void Configure(const std::vector<G4double>& edges, G4double area,
+                   const EnergyBinning& groups, G4int batchSize);
+
+    G4bool IsActive() const { return !fInverseVolumes.empty(); }
+
+    // Neutron step between z1 and z2: its weighted track length is shared
+    // among the cells in proportion to the z extent inside each
+    void Score(G4double z1, G4double z2, G4double energy, G4double trackLength);
+
+    SpectrumAccumulable& GetAccumulable() { return fFlux; }
+    void EndOfEvent() { fFlux.EndOfEvent(); }
+    void Flush() { fFlux.Flush(); }
+
+    // Master, after the merge
+    Windows MakeWindows(G4int nofEvents) const;
+    void WriteWindows(const G4String& fileName, const Windows& windows, G4int runID,
+                      G4int nofEvents) const;
+    void WriteFlux(const G4String& fileName, G4int runID, G4int nofEvents) const;
+    // Flux and largest group error per cell, for the run summary
+    void PrintSummary(std::ostream& out, G4int nofEvents) const;
+
+  private:
+    G4int GetNumberOfCells() const { return static_cast<G4int>(fInverseVolumes.size()); }
+
+    std::vector<G4double> fEdges;           // cells + 1
+    std::vector<G4double> fInverseVolumes;  // cm3 / volume
+    SpectrumAccumulable fFlux{"WeightWindowFlux"};
+};
+
+}  // namespace B1
+
+#endif
@@ -0,0 +1,64 @@
+import os
+import re
+import subprocess
+
+# Compares the neutronics physics list and the stacking modes against full
+# QGSP_BIC_HP transport: event rate, TBR and total heating. Run from the
+# build directory, next to exampleB1.
+script_dir = os.path.dirname(os.path.abspath(__file__))
+executable = os.path.join(script_dir, 'exampleB1')
+macro = 'run.mac'
+summary_file = os.path.join(script_dir, 'neutron_spectrum.txt')
+bench_macro = os.path.join(script_dir, 'physics_bench.mac')
+
+# (label, -p argument, commands before /run/initialize, commands after it);
+# run.mac follows
+variants = [
+    ('QGSP_BIC_HP', 'QGSP_BIC_HP', [], []),
+    ('neutronics standard', 'neutronics', [], []),
+    ('neutronics fast', 'neutronics', ['/B1/physics/em fast'], []),
+    ('neutronics fast, local < 100 keV', 'neutronics',
+     ['/B1/physics/em fast',
+      '/B1/physics/gammaLocalDeposit 100 keV',
+      '/B1/physics/electronLocalDeposit 100 keV'], []),
+    ('neutronics fast, local < 1 MeV', 'neutronics',
+     ['/B1/physics/em fast',
+      '/B1/physics/gammaLocalDeposit 1 MeV',
+      '/B1/physics/electronLocalDeposit 1 MeV'], []),
+    ('neutronics fast, no photonuclear', 'neutronics',
+     ['/B1/physics/em fast', '/B1/physics/photoNuclear false'], []),
+    ('QGSP_BIC_HP, stack kill', 'QGSP_BIC_HP', [], ['/B1/stack/mode kill']),
+    ('QGSP_BIC_HP, stack defer, drop 1%', 'QGSP_BIC_HP', [],
+     ['/B1/stack/mode defer', '/B1/run/dropDeferredRelErr 0.01']),
+]
+
+rate_pattern = re.compile(r'\(([0-9.eE+-]+) events/s\)')
+tbr_pattern = re.compile(r'Analog \(.*\): ([0-9.eE+-]+) \(rel\. error ([0-9.eE+-]+)')
+edep_pattern = re.compile(r'Total energy deposited: ([0-9.eE+-]+) (\w+)')
+to_MeV = {'eV': 1e-6, 'keV': 1e-3, 'MeV': 1.0, 'GeV': 1e3, 'TeV': 1e6, 'PeV': 1e9}
+
+def measure(physics, pre_init, post_init):
+    # Stacking commands exist once the workers have been started
+    commands = pre_init + ['/run/initialize'] + post_init + ['/control/execute ' + macro]
+    with open(bench_macro, 'w') as file:
+        file.write('\n'.join(commands) + '\n')
+    subprocess.run([executable, bench_macro, '-p', physics], cwd=script_dir,
+                   stdout=subprocess.DEVNULL, check=True)
+    with open(summary_file, 'r') as file:
+        text = file.read()
+    rate = float(rate_pattern.findall(text)[-1])
+    tbr, tbr_error = map(float, tbr_pattern.findall(text)[-1])
+    value, unit = edep_pattern.findall(text)[-1]
+    return rate, tbr, tbr_error, float(value) * to_MeV[unit]
+
+results = [(label,) + measure(physics, pre_init, post_init)
+           for label, physics, pre_init, post_init in variants]
+_, reference_rate, reference_tbr, _, reference_edep = results[0]
+
+print(f"{'physics':36s} {'events/s':>10s} {'speed-up':>9s} {'TBR':>16s} {'dTBR':>8s} {'dHeat':>8s}")
+for label, rate, tbr, tbr_error, edep in results:
+    print(f"{label:36s} {rate:10.1f} {rate / reference_rate:9.2f} "
+          f"{tbr:8.4f}+-{tbr * tbr_error:6.4f} {tbr / reference_tbr - 1:+8.2%} "
+          f"{edep / reference_edep - 1:+8.2%}")
+
+os.remove(bench_macro)
@@ -0,0 +1,56 @@
+import os
+import re
+import shutil
+import subprocess
+import matplotlib.pyplot as plt
+
+# Set default font sizes for consistency
+plt.rcParams.update({
+    'axes.titlesize': 16,
+    'axes.labelsize': 14,
+    'xtick.labelsize': 14,
+    'ytick.labelsize': 14,
+    'legend.fontsize': 12
+})
+
+# Run from the build directory, next to the exampleB1 executable
+script_dir = os.path.dirname(os.path.abspath(__file__))
+executable = os.path.join(script_dir, 'exampleB1')
+macro = 'run.mac'
+summary_file = os.path.join(script_dir, 'neutron_spectrum.txt')
+
+thread_counts = [1, 2, 4, 8, 16, 32, 64]
+
+# Event rate printed by RunAction in the global run summary
+rate_pattern = re.compile(r'\(([0-9.eE+-]+) events/s\)')
+
+def measure(extra_args):
+    subprocess.run([executable, macro] + extra_args, cwd=script_dir,
+                   stdout=subprocess.DEVNULL, check=True)
+    with open(summary_file, 'r') as file:
+        rates = rate_pattern.findall(file.read())
+    return float(rates[-1]) if rates else 0.0
+
+# Serial baseline (G4RunManager), then MT with increasing worker count
+serial_rate = measure(['-r', 'Serial'])
+shutil.copy(summary_file, os.path.join(script_dir, 'neutron_spectrum_serial.txt'))
+print(f"Serial: {serial_rate:.1f} events/s")
+
+speedups = []
+for n in thread_counts:
+    rate = measure(['-r', 'MT', '-t', str(n)])
+    speedups.append(rate / serial_rate if serial_rate > 0 else 0.0)
+    print(f"MT {n:3d} threads: {rate:.1f} events/s, speed-up {speedups[-1]:.2f}")
+
+plt.figure(figsize=(8, 6))
+plt.plot(thread_counts, speedups, 'o-', label='MT')
+plt.plot(thread_counts, thread_counts, 'k--', linewidth=1, label='Ideal')
+plt.xscale('log', base=2)
+plt.yscale('log', base=2)
+plt.xlabel('Worker threads')
+plt.ylabel('Speed-up vs. serial run manager')
+plt.legend()
+plt.grid(which='both')
+plt.tight_layout()
+plt.savefig(os.path.join(script_dir, 'scaling.png'))
+plt.show()
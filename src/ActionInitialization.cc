@@ -0,0 +1,66 @@
+/// \file B1/src/ActionInitialization.cc
+/// \brief Implementation of the B1::ActionInitialization class
+
+#include "ActionInitialization.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "RunAction.hh"
+#include "EventAction.hh"
+#include "SteppingAction.hh"
+#include "StackingAction.hh"
+#include "DetectorConstruction.hh"
+#include "ImportanceGeometry.hh"
+
+#include "G4RunManager.hh"
+
+namespace
+{
+// Cells registered by exampleB1 -b, null without biasing
+const B1::ImportanceGeometry* FindBiasingCells(const B1::DetectorConstruction* detector)
+{
+  for (G4int i = 0; i < detector->GetNumberOfParallelWorld(); ++i) {
+    if (auto cells = dynamic_cast<const B1::ImportanceGeometry*>(detector->GetParallelWorld(i))) {
+      return cells;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+namespace B1
+{
+
+void ActionInitialization::BuildForMaster() const
+{
+  const auto* detectorConstruction = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+  // Only RunAction is needed for master thread
+  RunAction* runAction = new RunAction(&detectorConstruction->GetVolumeRegistry(),
+                                       FindBiasingCells(detectorConstruction));
+  SetUserAction(runAction);
+}
+
+void ActionInitialization::Build() const
+{
+  // Access detector construction if needed (const-safe cast)
+  const DetectorConstruction* detectorConstruction =
+      static_cast<const DetectorConstruction*>(G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
+  // The registry is filled later, by Construct(); only its address is kept
+  const VolumeRegistry* volumes = &detectorConstruction->GetVolumeRegistry();
+
+  // Create and register user actions
+  auto* runAction    = new RunAction(volumes, FindBiasingCells(detectorConstruction));
+  auto* eventAction  = new EventAction(runAction, volumes);
+  auto* genAction    = new PrimaryGeneratorAction(volumes);
+  auto* stepAction   = new SteppingAction(eventAction, runAction, volumes);
+  auto* stackAction  = new StackingAction(eventAction, runAction, volumes);
+
+  SetUserAction(genAction);
+  SetUserAction(runAction);
+  SetUserAction(eventAction);
+  SetUserAction(stepAction);
+  SetUserAction(stackAction);
+}
+
+}  // namespace B1
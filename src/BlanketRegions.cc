@@ -0,0 +1,198 @@
+/// \file B1/src/BlanketRegions.cc
+/// \brief Implementation of the B1::BlanketRegions and B1::RegionMessenger classes
+
+#include "BlanketRegions.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4ProductionCuts.hh"
+#include "G4ProductionCutsTable.hh"
+#include "G4Region.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+#include "G4UnitsTable.hh"
+#include "G4UserLimits.hh"
+
+#include <sstream>
+
+namespace
+{
+const char* zoneNames[B1::BlanketRegions::kNumberOfZones + 1] = {"FirstWall", "Multiplier",
+                                                                 "Breeder", "Structure", "World"};
+
+// Region name, value and unit, e.g. "Breeder 1 mm"
+G4UIcommand* MakeRegionCommand(const G4String& path, G4UImessenger* messenger,
+                               const G4String& value, const G4String& unitCategory,
+                               const G4String& defaultUnit)
+{
+  auto command = new G4UIcommand(path, messenger);
+  auto region = new G4UIparameter("region", 's', false);
+  region->SetParameterCandidates("FirstWall Multiplier Breeder Structure");
+  command->SetParameter(region);
+  auto number = new G4UIparameter(value, 'd', false);
+  number->SetParameterRange(value + ">=0");
+  command->SetParameter(number);
+  auto unit = new G4UIparameter("unit", 's', true);
+  unit->SetDefaultValue(defaultUnit);
+  unit->SetParameterCandidates(G4UIcommand::UnitsList(unitCategory));
+  command->SetParameter(unit);
+  command->AvailableForStates(G4State_PreInit, G4State_Idle);
+  command->SetToBeBroadcasted(false);
+  return command;
+}
+}  // namespace
+
+namespace B1
+{
+
+BlanketRegions::BlanketRegions()
+{
+  for (G4int zone = 0; zone < kNumberOfZones; ++zone) {
+    fRegions[zone] = new G4Region(zoneNames[zone]);
+  }
+  fMessenger = new RegionMessenger(this);
+}
+
+BlanketRegions::~BlanketRegions()
+{
+  // The regions belong to G4RegionStore
+  delete fMessenger;
+}
+
+const char* BlanketRegions::GetZoneName(G4int zone)
+{
+  return zoneNames[zone];
+}
+
+void BlanketRegions::Attach(G4LogicalVolume* logical, VolumeRegistry::VolumeKind kind)
+{
+  Zone zone = GetZone(kind);
+  if (zone != kOutside) fRegions[zone]->AddRootLogicalVolume(logical);
+}
+
+void BlanketRegions::Detach()
+{
+  for (auto region : fRegions) {
+    std::vector<G4LogicalVolume*> roots(region->GetRootLogicalVolumeIterator(),
+                                        region->GetRootLogicalVolumeIterator()
+                                          + region->GetNumberOfRootVolumes());
+    for (auto logical : roots) {
+      region->RemoveRootLogicalVolume(logical, false);
+    }
+  }
+}
+
+void BlanketRegions::SetCut(Zone zone, G4double cut, const G4String& particle)
+{
+  // The kernel may have given the region the default cuts themselves
+  G4ProductionCuts* defaultCuts =
+    G4ProductionCutsTable::GetProductionCutsTable()->GetDefaultProductionCuts();
+  G4ProductionCuts* cuts = fRegions[zone]->GetProductionCuts();
+  if (!cuts || cuts == defaultCuts) {
+    cuts = new G4ProductionCuts(*defaultCuts);
+    fRegions[zone]->SetProductionCuts(cuts);
+  }
+  if (particle == "all") {
+    cuts->SetProductionCut(cut);
+  }
+  else {
+    cuts->SetProductionCut(cut, particle);
+  }
+}
+
+void BlanketRegions::SetMaxStep(Zone zone, G4double step)
+{
+  G4UserLimits* limits = fRegions[zone]->GetUserLimits();
+  if (!limits) {
+    limits = new G4UserLimits();
+    fRegions[zone]->SetUserLimits(limits);
+  }
+  limits->SetMaxAllowedStep(step > 0. ? step : DBL_MAX);
+}
+
+void BlanketRegions::SetMinKineticEnergy(Zone zone, G4double energy)
+{
+  G4UserLimits* limits = fRegions[zone]->GetUserLimits();
+  if (!limits) {
+    limits = new G4UserLimits();
+    fRegions[zone]->SetUserLimits(limits);
+  }
+  limits->SetUserMinEkine(energy);
+}
+
+void BlanketRegions::SetMaxTime(Zone zone, G4double time)
+{
+  G4UserLimits* limits = fRegions[zone]->GetUserLimits();
+  if (!limits) {
+    limits = new G4UserLimits();
+    fRegions[zone]->SetUserLimits(limits);
+  }
+  limits->SetUserMaxTime(time > 0. ? time : DBL_MAX);
+}
+
+RegionMessenger::RegionMessenger(BlanketRegions* regions)
+  : fRegions(regions)
+{
+  fDirectory = new G4UIdirectory("/B1/region/");
+  fDirectory->SetGuidance("Cuts and user limits of the FirstWall, Multiplier, Breeder and");
+  fDirectory->SetGuidance("Structure regions. /run/dumpRegion prints the current settings.");
+
+  fCutCmd = MakeRegionCommand("/B1/region/cut", this, "cut", "Length", "mm");
+  fCutCmd->SetGuidance("Production cut of one region, for one particle or all.");
+  auto particle = new G4UIparameter("particle", 's', true);
+  particle->SetDefaultValue("all");
+  particle->SetParameterCandidates("all gamma e- e+ proton");
+  fCutCmd->SetParameter(particle);
+
+  fMaxStepCmd = MakeRegionCommand("/B1/region/maxStep", this, "step", "Length", "mm");
+  fMaxStepCmd->SetGuidance("Maximum step length in one region; 0 removes the limit.");
+
+  fMinEkinCmd = MakeRegionCommand("/B1/region/minEkin", this, "energy", "Energy", "keV");
+  fMinEkinCmd->SetGuidance("Stop charged particles below this kinetic energy in one region,");
+  fMinEkinCmd->SetGuidance("depositing it there; 0 removes the limit.");
+
+  fMaxTimeCmd = MakeRegionCommand("/B1/region/maxTime", this, "time", "Time", "ns");
+  fMaxTimeCmd->SetGuidance("Kill tracks older than this global time in one region;");
+  fMaxTimeCmd->SetGuidance("0 removes the limit.");
+}
+
+RegionMessenger::~RegionMessenger()
+{
+  delete fMaxTimeCmd;
+  delete fMinEkinCmd;
+  delete fMaxStepCmd;
+  delete fCutCmd;
+  delete fDirectory;
+}
+
+void RegionMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  std::istringstream is(newValue);
+  G4String name, unit;
+  G4double value = 0.;
+  is >> name >> value >> unit;
+  value *= G4UIcommand::ValueOf(unit);
+
+  auto zone = BlanketRegions::kOutside;
+  for (G4int i = 0; i < BlanketRegions::kNumberOfZones; ++i) {
+    if (name == BlanketRegions::GetZoneName(i)) zone = static_cast<BlanketRegions::Zone>(i);
+  }
+  if (zone == BlanketRegions::kOutside) return;  // excluded by the candidates
+
+  if (command == fCutCmd) {
+    G4String particle;
+    is >> particle;
+    fRegions->SetCut(zone, value, particle);
+  }
+  else if (command == fMaxStepCmd) {
+    fRegions->SetMaxStep(zone, value);
+  }
+  else if (command == fMinEkinCmd) {
+    fRegions->SetMinKineticEnergy(zone, value);
+  }
+  else if (command == fMaxTimeCmd) {
+    fRegions->SetMaxTime(zone, value);
+  }
+}
+
+}  // namespace B1
@@ -0,0 +1,140 @@
+/// \file B1/src/ConvergenceMonitor.cc
+/// \brief Implementation of the B1::ConvergenceMonitor class
+
+#include "ConvergenceMonitor.hh"
+
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace
+{
+G4Mutex monitorMutex = G4MUTEX_INITIALIZER;
+}  // namespace
+
+namespace B1
+{
+
+ConvergenceMonitor* ConvergenceMonitor::Instance()
+{
+  static ConvergenceMonitor instance;
+  return &instance;
+}
+
+void ConvergenceMonitor::SetTarget(G4double relativeError, const G4String& quantity)
+{
+  fTargetError = relativeError;
+  fTargetName = quantity;
+}
+
+void ConvergenceMonitor::SetDropTarget(G4double relativeError, const G4String& quantity)
+{
+  fDropError = relativeError;
+  fDropName = quantity;
+}
+
+void ConvergenceMonitor::BeginRun(const std::vector<G4String>& quantities)
+{
+  G4AutoLock lock(&monitorMutex);
+  fQuantities = quantities;
+  fSum.assign(quantities.size(), 0.);
+  fSum2.assign(quantities.size(), 0.);
+  fSumN.assign(quantities.size(), 0.);
+  fNEvents = 0.;
+  fNEvents2 = 0.;
+  fNBatches = 0;
+  fStop = false;
+  fDrop = false;
+  fDropBatch = -1;
+  fStopReason = "all events processed";
+  fStart = std::chrono::steady_clock::now();
+
+  auto it = std::find(fQuantities.begin(), fQuantities.end(), fTargetName);
+  fTargetIndex = (it != fQuantities.end()) ? static_cast<G4int>(it - fQuantities.begin()) : -1;
+  if (fTargetError > 0. && fTargetIndex < 0) {
+    G4ExceptionDescription msg;
+    msg << "Unknown quantity " << fTargetName << " for the relative error rule; it is ignored.";
+    G4Exception("ConvergenceMonitor::BeginRun()", "B1Conv0001", JustWarning, msg);
+  }
+
+  it = std::find(fQuantities.begin(), fQuantities.end(), fDropName);
+  fDropIndex = (it != fQuantities.end()) ? static_cast<G4int>(it - fQuantities.begin()) : -1;
+  if (fDropError > 0. && fDropIndex < 0) {
+    G4ExceptionDescription msg;
+    msg << "Unknown quantity " << fDropName << " for the drop rule; it is ignored.";
+    G4Exception("ConvergenceMonitor::BeginRun()", "B1Conv0001", JustWarning, msg);
+  }
+}
+
+void ConvergenceMonitor::AddBatch(const std::vector<G4double>& sums, G4int nofEvents)
+{
+  G4AutoLock lock(&monitorMutex);
+  if (sums.size() != fSum.size() || nofEvents <= 0) return;
+
+  for (std::size_t i = 0; i < sums.size(); ++i) {
+    fSum[i] += sums[i];
+    fSum2[i] += sums[i] * sums[i];
+    fSumN[i] += sums[i] * nofEvents;
+  }
+  fNEvents += nofEvents;
+  fNEvents2 += static_cast<G4double>(nofEvents) * nofEvents;
+  ++fNBatches;
+
+  if (!fDrop && fDropError > 0. && fDropIndex >= 0 && fNBatches >= fMinBatches) {
+    G4double error = RelativeErrorUnlocked(fDropIndex);
+    if (error > 0. && error < fDropError) {
+      fDropBatch = fNBatches;
+      fDrop = true;
+    }
+  }
+
+  if (fStop) return;
+
+  if (fMaxWallTime > 0. && WallTime() > fMaxWallTime) {
+    std::ostringstream os;
+    os << "wall time limit of " << fMaxWallTime << " s reached";
+    fStopReason = os.str();
+    fStop = true;
+  }
+  else if (fTargetError > 0. && fTargetIndex >= 0 && fNBatches >= fMinBatches) {
+    G4double error = RelativeErrorUnlocked(fTargetIndex);
+    if (error > 0. && error < fTargetError) {
+      std::ostringstream os;
+      os << fTargetName << " relative error " << error << " below " << fTargetError;
+      fStopReason = os.str();
+      fStop = true;
+    }
+  }
+}
+
+G4double ConvergenceMonitor::GetMean(G4int i) const
+{
+  G4AutoLock lock(&monitorMutex);
+  return (fNEvents > 0.) ? fSum[i] / fNEvents : 0.;
+}
+
+G4double ConvergenceMonitor::GetRelativeError(G4int i) const
+{
+  G4AutoLock lock(&monitorMutex);
+  return RelativeErrorUnlocked(i);
+}
+
+G4double ConvergenceMonitor::WallTime() const
+{
+  return std::chrono::duration<G4double>(std::chrono::steady_clock::now() - fStart).count();
+}
+
+G4double ConvergenceMonitor::RelativeErrorUnlocked(G4int i) const
+{
+  // Ratio estimator over batches b of n_b events and sum S_b:
+  // var(mean) = B / (B - 1) * sum_b (S_b - mean n_b)^2 / N^2
+  if (fNBatches < 2 || fSum[i] == 0.) return 0.;
+  G4double mean = fSum[i] / fNEvents;
+  G4double deviations = fSum2[i] - 2. * mean * fSumN[i] + mean * mean * fNEvents2;
+  G4double variance = fNBatches / (fNBatches - 1.) * deviations / (fNEvents * fNEvents);
+  return (variance > 0.) ? std::sqrt(variance) / std::abs(mean) : 0.;
+}
+
+}  // namespace B1
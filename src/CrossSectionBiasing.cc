@@ -0,0 +1,104 @@
+/// \file B1/src/CrossSectionBiasing.cc
+/// \brief Implementation of the B1::CrossSectionBiasing class
+
+#include "CrossSectionBiasing.hh"
+
+#include "G4BOptnChangeCrossSection.hh"
+#include "G4BiasingProcessInterface.hh"
+#include "G4BiasingProcessSharedData.hh"
+#include "G4Neutron.hh"
+#include "G4VPhysicalVolume.hh"
+
+#include <cfloat>
+
+namespace B1
+{
+
+G4ThreadLocal CrossSectionBiasing* CrossSectionBiasing::fInstance = nullptr;
+
+CrossSectionBiasing::CrossSectionBiasing(const VolumeRegistry* volumes)
+  : G4VBiasingOperator("CrossSectionBiasing"),
+    fVolumes(volumes)
+{
+  fInstance = this;
+}
+
+CrossSectionBiasing::~CrossSectionBiasing()
+{
+  for (auto& entry : fOperations) {
+    delete entry.second;
+  }
+  if (fInstance == this) fInstance = nullptr;
+}
+
+const char* CrossSectionBiasing::GetChannelName(G4int channel)
+{
+  return channel == kTritiumChannel ? "tritium" : "multiplication";
+}
+
+void CrossSectionBiasing::StartRun()
+{
+  if (!fOperations.empty()) return;
+
+  // One operation per wrapped neutron process, kept for the whole job
+  const G4BiasingProcessSharedData* sharedData =
+    G4BiasingProcessInterface::GetSharedData(G4Neutron::Definition()->GetProcessManager());
+  if (!sharedData) return;
+  for (const auto* wrapper : sharedData->GetPhysicsBiasingProcessInterfaces()) {
+    G4String name = "XSchange-" + wrapper->GetWrappedProcess()->GetProcessName();
+    fOperations[wrapper] = new G4BOptnChangeCrossSection(name);
+  }
+}
+
+G4VBiasingOperation* CrossSectionBiasing::ProposeOccurenceBiasingOperation(
+  const G4Track* track, const G4BiasingProcessInterface* callingProcess)
+{
+  // An unbiased step leaves no excess behind
+  fExcess = 0.;
+  fTrackID = 0;
+
+  G4int channel = GetChannel(fVolumes->GetKind(track->GetVolume()->GetCopyNo()));
+  if (channel < 0 || fFactors[channel] == 1.) return nullptr;
+
+  auto it = fOperations.find(callingProcess);
+  if (it == fOperations.end()) return nullptr;
+  G4BOptnChangeCrossSection* operation = it->second;
+
+  G4double analogLength = callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  if (analogLength > DBL_MAX / 10.) return nullptr;
+  G4double analogXS = 1. / analogLength;
+  G4double biasedXS = fFactors[channel] * analogXS;
+
+  // A flight sampled on the previous step goes on with the cross section
+  // of this one; after an interaction or an unbiased step it starts anew
+  const G4VBiasingOperation* previous = callingProcess->GetPreviousOccurenceBiasingOperation();
+  if (previous == operation && !operation->GetInteractionOccured()) {
+    operation->UpdateForStep(callingProcess->GetPreviousStepSize());
+    operation->SetBiasedCrossSection(biasedXS);
+    operation->UpdateForStep(0.);
+  }
+  else {
+    operation->SetBiasedCrossSection(biasedXS);
+    operation->Sample();
+  }
+
+  fEventID = GetEventID();
+  fTrackID = track->GetTrackID();
+  fStepNumber = track->GetCurrentStepNumber();
+  fExcess = biasedXS - analogXS;
+  return operation;
+}
+
+void CrossSectionBiasing::OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                           G4BiasingAppliedCase,
+                                           G4VBiasingOperation* occurenceOperationApplied,
+                                           G4double, G4VBiasingOperation*,
+                                           const G4VParticleChange*)
+{
+  auto it = fOperations.find(callingProcess);
+  if (it != fOperations.end() && it->second == occurenceOperationApplied) {
+    it->second->SetInteractionOccured();
+  }
+}
+
+}  // namespace B1
@@ -0,0 +1,232 @@
+/// \file B1/src/DetectorConstruction.cc
+/// \brief Implementation of the B1::DetectorConstruction class
+
+#include "DetectorConstruction.hh"
+#include "CrossSectionBiasing.hh"
+#include "ImportanceGeometry.hh"
+
+#include "G4BOptrForceCollision.hh"
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4PVPlacement.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "G4VisAttributes.hh"
+
+#include <algorithm>
+#include <cctype>
+
+namespace B1
+{
+
+DetectorConstruction::DetectorConstruction(const G4String& stackFile)
+  : fStackFile(stackFile)
+{}
+
+G4String DetectorConstruction::GetConceptStackFile(const G4String& concept)
+{
+  G4String fileName = concept;
+  std::transform(fileName.begin(), fileName.end(), fileName.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return fileName + ".stack";
+}
+
+void DetectorConstruction::ReleaseGeometry()
+{
+  fRegions.Detach();
+  for (G4int i = 0; i < GetNumberOfParallelWorld(); ++i) {
+    if (auto cells = dynamic_cast<ImportanceGeometry*>(GetParallelWorld(i))) {
+      cells->ReleaseCells();
+    }
+  }
+}
+
+G4VPhysicalVolume* DetectorConstruction::Construct()
+{
+  LayerStack stack = LayerStack::Read(fStackFile, fOverrides);
+
+  // Every placement uses its registry ID as copy number
+  fVolumes.Clear();
+  fSlabIDs.clear();
+
+  G4double env_sizeXY = stack.GetEnvelopeXY();
+  G4double env_sizeZ = stack.GetEnvelopeZ();
+  G4Material* env_mat = stack.GetMaterial(stack.GetEnvelopeMaterial());
+
+  G4double world_sizeXY = stack.GetWorldMargin() * env_sizeXY;
+  G4double world_sizeZ = stack.GetWorldMargin() * env_sizeZ;
+  G4Material* world_mat = stack.GetMaterial(stack.GetWorldMaterial());
+
+  auto solidWorld = new G4Box("World", 0.5 * world_sizeXY, 0.5 * world_sizeXY, 0.5 * world_sizeZ);
+  auto logicWorld = new G4LogicalVolume(solidWorld, world_mat, "World");
+  G4int worldID = fVolumes.Register("World", logicWorld, VolumeRegistry::kWorld);
+  auto physWorld = new G4PVPlacement(nullptr, {}, logicWorld, "World", nullptr, false, worldID, fCheckOverlaps);
+
+  auto solidEnv = new G4Box("Envelope", 0.5 * env_sizeXY, 0.5 * env_sizeXY, 0.5 * env_sizeZ);
+  auto logicEnv = new G4LogicalVolume(solidEnv, env_mat, "Envelope");
+  G4int envelopeID = fVolumes.Register("Envelope", logicEnv, VolumeRegistry::kEnvelope);
+  new G4PVPlacement(nullptr, {}, logicEnv, "Envelope", logicWorld, false, envelopeID, fCheckOverlaps);
+
+  // --- Blanket layers, front to back along z
+  PlaceLayers(stack, stack.GetLayers(), logicEnv, stack.GetFrontZ(), 0.);
+  fVolumes.SetDepthOrigin(stack.GetDepthOrigin());
+  fVolumes.SetSourcePlane(stack.GetSourceZ(), env_sizeXY);
+
+  // --- Neutron interface crossings scored by the stepping action
+  AddTransitions(envelopeID);
+
+  if (fForcedCollision) MarkForcedCollisionVolumes();
+
+  // Masses of the volumes without their daughters, for the dose report
+  fVolumes.ComputeMasses();
+
+  return physWorld;
+}
+
+void DetectorConstruction::ConstructSDandField()
+{
+  if (fCrossSectionBiasing) {
+    // The operator of a thread keeps its factors across geometry rebuilds;
+    // only the new slabs need attaching
+    CrossSectionBiasing* biasing = CrossSectionBiasing::GetInstance();
+    if (!biasing) biasing = new CrossSectionBiasing(&fVolumes);
+    for (G4int id = 0; id < fVolumes.GetSize(); ++id) {
+      if (CrossSectionBiasing::GetChannel(fVolumes.GetKind(id)) >= 0) {
+        biasing->AttachTo(fVolumes.GetLogical(id));
+      }
+    }
+  }
+
+  if (fForcedCollision) {
+    // Each entering neutron is cloned: one copy crosses without collision,
+    // its weight lowered to the uncollided fraction on the way out, the
+    // other collides inside with the collided fraction of the weight
+    static G4ThreadLocal G4BOptrForceCollision* forceCollision = nullptr;
+    if (!forceCollision) forceCollision = new G4BOptrForceCollision("neutron", "ForcedCollision");
+    for (G4int id = 0; id < fVolumes.GetSize(); ++id) {
+      if (fVolumes.IsForcedCollision(id)) forceCollision->AttachTo(fVolumes.GetLogical(id));
+    }
+  }
+}
+
+void DetectorConstruction::MarkForcedCollisionVolumes()
+{
+  auto matches = [](const G4String& pattern, const G4String& name) {
+    if (!pattern.empty() && pattern.back() == '*') {
+      return name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0;
+    }
+    return name == pattern;
+  };
+
+  G4int nForced = 0;
+  for (G4int id = 0; id < fVolumes.GetSize(); ++id) {
+    G4bool forced = fVolumes.GetKind(id) == VolumeRegistry::kFirstWall;
+    if (!fForcedCollisionVolumes.empty()) {
+      forced = std::any_of(fForcedCollisionVolumes.begin(), fForcedCollisionVolumes.end(),
+                           [&](const G4String& pattern) {
+                             return matches(pattern, fVolumes.GetName(id));
+                           });
+    }
+    // Containers hold the daughters the collisions would be forced in
+    if (forced && fVolumes.GetKind(id) != VolumeRegistry::kContainer) {
+      fVolumes.SetForcedCollision(id);
+      G4cout << "Forced neutron collisions in " << fVolumes.GetName(id) << G4endl;
+      ++nForced;
+    }
+  }
+  if (nForced == 0) {
+    G4Exception("DetectorConstruction::MarkForcedCollisionVolumes()", "B1Geo0005",
+                JustWarning, "No volume for forced collisions.");
+  }
+}
+
+void DetectorConstruction::PlaceLayers(const LayerStack& stack,
+                                       const std::vector<LayerStack::Layer>& layers,
+                                       G4LogicalVolume* mother, G4double front,
+                                       G4double motherZ)
+{
+  G4double halfXY = 0.5 * stack.GetLayerXY();
+  G4double z_cursor = front;
+
+  for (const auto& layer : layers) {
+    G4Material* material = stack.GetMaterial(layer.material, layer.enrichment);
+    G4VisAttributes* visAttributes =
+      layer.hasColour ? new G4VisAttributes(layer.colour) : nullptr;
+
+    // A container is placed as one box and filled from its front face
+    if (layer.kind == VolumeRegistry::kContainer) {
+      auto solid = new G4Box(layer.name, halfXY, halfXY, 0.5 * layer.thickness);
+      auto logical = new G4LogicalVolume(solid, material, layer.name);
+      G4int id = fVolumes.Register(layer.name, logical, layer.kind);
+      G4ThreeVector pos(0, 0, z_cursor + 0.5 * layer.thickness);
+      new G4PVPlacement(nullptr, pos, logical, layer.name, mother, false, id, fCheckOverlaps);
+      if (visAttributes) logical->SetVisAttributes(visAttributes);
+
+      PlaceLayers(stack, layer.layers, logical, -0.5 * layer.thickness, motherZ + pos.z());
+      z_cursor += layer.thickness;
+      continue;
+    }
+
+    // Segmented layers become equal slabs <name>_1 .. <name>_n, scored separately
+    G4double thick = layer.thickness / layer.segments;
+    for (G4int i = 0; i < layer.segments; ++i) {
+      G4String name = (layer.segments > 1) ? layer.name + "_" + std::to_string(i + 1)
+                                           : layer.name;
+      auto solid = new G4Box(name, halfXY, halfXY, 0.5 * thick);
+      auto logical = new G4LogicalVolume(solid, material, name);
+      G4int id = fVolumes.Register(name, logical, layer.kind);
+      G4ThreeVector pos(0, 0, z_cursor + 0.5 * thick);
+      new G4PVPlacement(nullptr, pos, logical, name, mother, false, id, fCheckOverlaps);
+      fVolumes.SetLayer(id, motherZ + z_cursor, motherZ + z_cursor + thick);
+      fSlabIDs.push_back(id);
+      fRegions.Attach(logical, layer.kind);
+      if (visAttributes) logical->SetVisAttributes(visAttributes);
+
+      z_cursor += thick;
+    }
+  }
+}
+
+void DetectorConstruction::AddTransitions(G4int envelopeID)
+{
+  // The neutron counts as effective when it enters the first slab behind
+  // the first wall, e.g. the PbLi or the first Be layer
+  G4int effectiveID = -1;
+  for (std::size_t i = 0; i + 1 < fSlabIDs.size(); ++i) {
+    if (fVolumes.GetKind(fSlabIDs[i]) == VolumeRegistry::kFirstWall
+        && fVolumes.GetKind(fSlabIDs[i + 1]) != VolumeRegistry::kFirstWall)
+    {
+      effectiveID = fSlabIDs[i + 1];
+      break;
+    }
+  }
+
+  for (auto from : fSlabIDs) {
+    auto fromKind = fVolumes.GetKind(from);
+    if (fromKind == VolumeRegistry::kFirstWall) {
+      fVolumes.AddTransition(envelopeID, from, VolumeRegistry::kBeforeW);
+      fVolumes.AddTransition(from, envelopeID, VolumeRegistry::kBackscatter);
+      if (effectiveID >= 0) {
+        fVolumes.AddTransition(from, effectiveID, VolumeRegistry::kEffective);
+      }
+    }
+    else if (fromKind == VolumeRegistry::kBackPlate) {
+      fVolumes.AddTransition(from, envelopeID, VolumeRegistry::kAfterEUROFER);
+    }
+
+    for (auto to : fSlabIDs) {
+      auto toKind = fVolumes.GetKind(to);
+      if (fromKind == VolumeRegistry::kFirstWall
+          && (toKind == VolumeRegistry::kMultiplier || toKind == VolumeRegistry::kBreeder))
+      {
+        fVolumes.AddTransition(from, to, VolumeRegistry::kAfterW);
+      }
+      else if (fromKind == VolumeRegistry::kBreeder && toKind == VolumeRegistry::kBackPlate) {
+        fVolumes.AddTransition(from, to, VolumeRegistry::kBeforeEUROFER);
+      }
+    }
+  }
+}
+
+}  // namespace B1
@@ -0,0 +1,153 @@
+/// \file B1/src/EnergyBinning.cc
+/// \brief Implementation of the B1::EnergyBinning class
+
+#include "EnergyBinning.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+// VITAMIN-J 175-group structure, boundaries in eV from low to high
+const G4double vitaminJ175[] = {
+  1.0000e-05, 1.0000e-01, 4.1399e-01, 5.3158e-01, 6.8256e-01, 8.7642e-01, 1.1254e+00,
+  1.4450e+00, 1.8554e+00, 2.3824e+00, 3.0590e+00, 3.9279e+00, 5.0435e+00, 6.4760e+00,
+  8.3153e+00, 1.0677e+01, 1.3710e+01, 1.7604e+01, 2.2603e+01, 2.9023e+01, 3.7267e+01,
+  4.7851e+01, 6.1442e+01, 7.8893e+01, 1.0130e+02, 1.3007e+02, 1.6702e+02, 2.1445e+02,
+  2.7536e+02, 3.5357e+02, 4.5400e+02, 5.8295e+02, 7.4852e+02, 9.6112e+02, 1.2341e+03,
+  1.5846e+03, 2.0347e+03, 2.2487e+03, 2.4852e+03, 2.6126e+03, 2.7465e+03, 3.0354e+03,
+  3.3546e+03, 3.7074e+03, 4.3074e+03, 5.5308e+03, 7.1017e+03, 9.1188e+03, 1.0595e+04,
+  1.1709e+04, 1.5034e+04, 1.9305e+04, 2.1875e+04, 2.3579e+04, 2.4176e+04, 2.4788e+04,
+  2.6058e+04, 2.7000e+04, 2.8501e+04, 3.1828e+04, 3.4307e+04, 4.0868e+04, 4.6309e+04,
+  5.2475e+04, 5.6562e+04, 6.7379e+04, 7.1998e+04, 7.9499e+04, 8.2503e+04, 8.6517e+04,
+  9.8037e+04, 1.1109e+05, 1.1679e+05, 1.2277e+05, 1.2907e+05, 1.3569e+05, 1.4264e+05,
+  1.4996e+05, 1.5764e+05, 1.6573e+05, 1.7422e+05, 1.8316e+05, 1.9255e+05, 2.0242e+05,
+  2.1280e+05, 2.2371e+05, 2.3518e+05, 2.4724e+05, 2.7324e+05, 2.8725e+05, 2.9452e+05,
+  2.9720e+05, 2.9850e+05, 3.0197e+05, 3.3373e+05, 3.6883e+05, 3.8774e+05, 4.0762e+05,
+  4.5049e+05, 4.9787e+05, 5.2340e+05, 5.5023e+05, 5.7844e+05, 6.0810e+05, 6.3928e+05,
+  6.7206e+05, 7.0651e+05, 7.4274e+05, 7.8082e+05, 8.2085e+05, 8.6294e+05, 9.0718e+05,
+  9.6164e+05, 1.0026e+06, 1.1080e+06, 1.1648e+06, 1.2246e+06, 1.2874e+06, 1.3534e+06,
+  1.4227e+06, 1.4957e+06, 1.5724e+06, 1.6530e+06, 1.7377e+06, 1.8268e+06, 1.9205e+06,
+  2.0190e+06, 2.1225e+06, 2.2313e+06, 2.3069e+06, 2.3457e+06, 2.3653e+06, 2.3852e+06,
+  2.4660e+06, 2.5924e+06, 2.7253e+06, 2.8651e+06, 3.0119e+06, 3.1664e+06, 3.3287e+06,
+  3.6788e+06, 4.0657e+06, 4.4933e+06, 4.7237e+06, 4.9659e+06, 5.2205e+06, 5.4881e+06,
+  5.7695e+06, 6.0653e+06, 6.3763e+06, 6.5924e+06, 6.7032e+06, 7.0469e+06, 7.4082e+06,
+  7.7880e+06, 8.1873e+06, 8.6071e+06, 9.0484e+06, 9.5123e+06, 1.0000e+07, 1.0513e+07,
+  1.1052e+07, 1.1618e+07, 1.2214e+07, 1.2523e+07, 1.2840e+07, 1.3499e+07, 1.3840e+07,
+  1.4191e+07, 1.4550e+07, 1.4918e+07, 1.5683e+07, 1.6487e+07, 1.6905e+07, 1.7333e+07,
+  1.9640e+07,
+};
+}  // namespace
+
+namespace B1
+{
+
+EnergyBinning::EnergyBinning(Scale scale, G4int nBins, G4double eMin, G4double eMax)
+  : fScale(scale),
+    fName(scale == kLinear ? "lin" : "log"),
+    fNBins(nBins)
+{
+  if (scale == kGroups || nBins <= 0 || eMax <= eMin
+      || (scale == kLogarithmic && eMin <= 0.))
+  {
+    G4ExceptionDescription msg;
+    msg << "Invalid binning: " << nBins << " bins from " << eMin << " to " << eMax << ".";
+    G4Exception("EnergyBinning::EnergyBinning()", "B1Bin0001", FatalException, msg);
+    return;
+  }
+
+  G4double low = (scale == kLinear) ? eMin : std::log(eMin);
+  G4double high = (scale == kLinear) ? eMax : std::log(eMax);
+  fLow = low;
+  fInverseWidth = nBins / (high - low);
+
+  fEdges.resize(nBins + 1);
+  for (G4int i = 0; i <= nBins; ++i) {
+    G4double x = low + i * (high - low) / nBins;
+    fEdges[i] = (scale == kLinear) ? x : std::exp(x);
+  }
+}
+
+EnergyBinning::EnergyBinning(std::vector<G4double> edges, const G4String& name)
+  : fScale(kGroups),
+    fName(name),
+    fEdges(std::move(edges))
+{
+  // Libraries list group boundaries from high to low energy
+  std::sort(fEdges.begin(), fEdges.end());
+  fEdges.erase(std::unique(fEdges.begin(), fEdges.end()), fEdges.end());
+  if (fEdges.size() < 2 || fEdges.front() < 0.) {
+    G4ExceptionDescription msg;
+    msg << "Group structure " << name << " needs at least two non-negative boundaries.";
+    G4Exception("EnergyBinning::EnergyBinning()", "B1Bin0002", FatalException, msg);
+    return;
+  }
+  fNBins = static_cast<G4int>(fEdges.size()) - 1;
+
+  fSearchSize = 1;
+  while (fSearchSize < static_cast<G4int>(fEdges.size())) {
+    fSearchSize *= 2;
+  }
+  fSearch.assign(fSearchSize, DBL_MAX);
+  std::copy(fEdges.begin(), fEdges.end(), fSearch.begin());
+}
+
+EnergyBinning EnergyBinning::FromFile(const G4String& fileName, G4double unit)
+{
+  std::ifstream in(fileName);
+  if (!in.is_open()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open group structure file " << fileName << ".";
+    G4Exception("EnergyBinning::FromFile()", "B1Bin0003", FatalException, msg);
+    return EnergyBinning();
+  }
+
+  std::vector<G4double> edges;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream is(line.substr(0, line.find('#')));
+    G4double value;
+    while (is >> value) {
+      edges.push_back(value * unit);
+    }
+  }
+
+  // Name the structure after the file, without directory and extension
+  G4String name = fileName.substr(fileName.find_last_of('/') + 1);
+  return EnergyBinning(std::move(edges), name.substr(0, name.find_last_of('.')));
+}
+
+EnergyBinning EnergyBinning::FromName(const G4String& name)
+{
+  if (name == "VITAMIN-J-175") {
+    std::vector<G4double> edges;
+    for (G4double edge : vitaminJ175) {
+      edges.push_back(edge * eV);
+    }
+    return EnergyBinning(std::move(edges), name);
+  }
+
+  G4ExceptionDescription msg;
+  msg << "Unknown group structure " << name << "; known: " << GetStandardNames() << ".";
+  G4Exception("EnergyBinning::FromName()", "B1Bin0004", FatalException, msg);
+  return EnergyBinning();
+}
+
+G4double EnergyBinning::GetLethargyWidth(G4int bin) const
+{
+  return (fEdges[bin] > 0.) ? std::log(fEdges[bin + 1] / fEdges[bin]) : 0.;
+}
+
+G4String EnergyBinning::GetDescription() const
+{
+  std::ostringstream os;
+  os << fName << ", " << fNBins << " bins from " << fEdges.front() / MeV << " to "
+     << fEdges.back() / MeV << " MeV";
+  return os.str();
+}
+
+}  // namespace B1
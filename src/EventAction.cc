@@ -0,0 +1,114 @@
+#include "EventAction.hh"
+#include "RunAction.hh"
+#include "VolumeRegistry.hh"
+#include "BlanketRegions.hh"
+#include "Logger.hh"
+
+namespace B1
+{
+
+EventAction::EventAction(RunAction* runAction, const VolumeRegistry* volumes)
+  : fRunAction(runAction),
+    fVolumes(volumes)
+{}
+
+void EventAction::BeginOfEventAction(const G4Event*)
+{
+  fEdep = 0.;
+
+  fEdepByVolume.assign(fVolumes->GetSize(), 0.);
+  fTritiumByLayer.assign(fVolumes->GetNumberOfLayers(), 0.);
+  fRegionSteps.assign((BlanketRegions::kNumberOfZones + 1) * RunAction::kNumberOfStepClasses, 0.);
+  fCutoffScores.assign((BlanketRegions::kNumberOfZones + 1) * RunAction::kNumberOfCutoffScores,
+                       0.);
+  fTritiumCount = 0.;
+  fHeliumCount = 0.;
+  fMultiplicationCount = 0.;
+
+  fBackscattered = false;
+  fNeutronInCount = 0;
+
+  fEffectiveNeutrons = 0.;
+}
+
+void EventAction::EndOfEventAction(const G4Event*)
+{
+  fRunAction->AddEdep(fEdep);
+  fRunAction->AddTritium(fTritiumCount);
+  fRunAction->AddHelium(fHeliumCount);
+  fRunAction->AddMultiplication(fMultiplicationCount);
+  fRunAction->AddTritiumEstimates(fTritiumCount, fTritiumByLayer);
+
+  for (std::size_t id = 0; id < fEdepByVolume.size(); ++id) {
+    if (fEdepByVolume[id] > 0.) fRunAction->AddEdepByVolume(id, fEdepByVolume[id]);
+  }
+
+  fRunAction->AddRegionSteps(fRegionSteps);
+  fRunAction->AddCutoffScores(fCutoffScores);
+  fRunAction->AddEffectiveNeutrons(fEffectiveNeutrons);
+
+  fRunAction->EndOfEvent();
+
+  B1_LOG(kTriton, kEventSummary) << "[TRITON] Tritium count this event: " << fTritiumCount << G4endl;
+  B1_LOG(kHelium, kEventSummary) << "[HELIUM] Helium (alpha) count this event: " << fHeliumCount << G4endl;
+
+  // Cut neutrons, and the share of the steps they would have taken, as
+  // estimated from the survivors of this event
+  G4double cutScores[RunAction::kNumberOfCutoffScores] = {};
+  for (std::size_t i = 0; i < fCutoffScores.size(); ++i) {
+    cutScores[i % RunAction::kNumberOfCutoffScores] += fCutoffScores[i];
+  }
+  G4double killed = cutScores[RunAction::kCutoffKilled];
+  G4double survivors = cutScores[RunAction::kCutoffSurvivors];
+  if (killed + survivors > 0.) {
+    G4double steps = 0.;
+    for (auto count : fRegionSteps) {
+      steps += count;
+    }
+    G4double savedSteps =
+      (survivors > 0.) ? killed * cutScores[RunAction::kCutoffSurvivorSteps] / survivors : 0.;
+    B1_LOG(kEvent, kEventSummary)
+      << "[CUTOFF] Neutrons killed this event: " << killed << ", survived: " << survivors
+      << ", weight lost: "
+      << cutScores[RunAction::kCutoffKilledWeight] - cutScores[RunAction::kCutoffAddedWeight]
+      << ", estimated CPU time saved: "
+      << (survivors > 0. ? 100. * savedSteps / (steps + savedSteps) : 0.) << " %" << G4endl;
+  }
+}
+
+void EventAction::AddCutoffKill(G4int zone, G4double weight)
+{
+  G4double* scores = &fCutoffScores[zone * RunAction::kNumberOfCutoffScores];
+  scores[RunAction::kCutoffKilled] += 1.;
+  scores[RunAction::kCutoffKilledWeight] += weight;
+}
+
+G4int EventAction::AddCutoffSurvivor(G4int zone, G4double addedWeight)
+{
+  G4double* scores = &fCutoffScores[zone * RunAction::kNumberOfCutoffScores];
+  scores[RunAction::kCutoffSurvivors] += 1.;
+  scores[RunAction::kCutoffAddedWeight] += addedWeight;
+  return zone * RunAction::kNumberOfCutoffScores + RunAction::kCutoffSurvivorSteps;
+}
+
+void EventAction::AddEnergyBeforeW(G4double energy, G4double weight)
+{
+  fRunAction->FillSpectrum(RunAction::kSpectrumBeforeW, energy, weight);
+}
+
+void EventAction::AddEnergyAfterW(G4double energy, G4double weight)
+{
+  fRunAction->FillSpectrum(RunAction::kSpectrumAfterW, energy, weight);
+}
+
+void EventAction::AddEnergyBeforeEUROFER(G4double energy, G4double weight)
+{
+  fRunAction->FillSpectrum(RunAction::kSpectrumBeforeEUROFER, energy, weight);
+}
+
+void EventAction::AddEnergyAfterEUROFER(G4double energy, G4double weight)
+{
+  fRunAction->FillSpectrum(RunAction::kSpectrumAfterEUROFER, energy, weight);
+}
+
+}  // namespace B1
@@ -0,0 +1,287 @@
+/// \file B1/src/ImportanceGeometry.cc
+/// \brief Implementation of the B1::ImportanceGeometry and B1::ImportanceMessenger classes
+
+#include "ImportanceGeometry.hh"
+#include "VolumeRegistry.hh"
+
+#include "G4Box.hh"
+#include "G4GeometryCell.hh"
+#include "G4IStore.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+#include "G4WeightWindowStore.hh"
+
+#include <cfloat>
+#include <cmath>
+#include <set>
+#include <sstream>
+
+namespace B1
+{
+
+ImportanceGeometry::ImportanceGeometry(const G4String& worldName, const VolumeRegistry* volumes,
+                                       Mode mode)
+  : G4VUserParallelWorld(worldName),
+    fVolumes(volumes),
+    fMode(mode)
+{
+  SetNumberOfSlabs(10);
+  SetWindowGroups(10);
+  fMessenger = new ImportanceMessenger(this);
+}
+
+ImportanceGeometry::~ImportanceGeometry()
+{
+  delete fMessenger;
+}
+
+void ImportanceGeometry::Construct()
+{
+  fGhostWorld = GetWorld();
+  G4LogicalVolume* worldLogical = fGhostWorld->GetLogicalVolume();
+  auto worldBox = static_cast<const G4Box*>(worldLogical->GetSolid());
+  G4double halfXY = worldBox->GetXHalfLength();
+  G4double halfZ = worldBox->GetZHalfLength();
+  fCellArea = 4. * halfXY * halfXY;
+
+  // Biased zone: behind the first wall, to the back of the last layer
+  G4int nLayers = fVolumes->GetNumberOfLayers();
+  G4int first = 0;
+  while (first < nLayers
+         && fVolumes->GetKind(fVolumes->GetLayerID(first)) == VolumeRegistry::kFirstWall)
+  {
+    ++first;
+  }
+  if (first == nLayers) {
+    G4Exception("ImportanceGeometry::Construct()", "B1Bias0001", FatalException,
+                "No layer behind the first wall to bias.");
+    return;
+  }
+  G4double frontZ = fVolumes->GetLayerFrontZ(first);
+  G4double backZ = fVolumes->GetLayerBackZ(nLayers - 1);
+
+  // Cell boundaries along z: world front, the slabs, world back
+  G4int nSlabs = static_cast<G4int>(fImportances.size());
+  std::vector<G4double> edges = {-halfZ};
+  for (G4int i = 0; i <= nSlabs; ++i) {
+    edges.push_back(frontZ + i * (backZ - frontZ) / nSlabs);
+  }
+  edges.push_back(halfZ);
+  fEdges = edges;
+
+  fCells.clear();
+  for (std::size_t i = 0; i + 1 < edges.size(); ++i) {
+    G4String name = (fMode == kImportance ? "ImportanceCell_" : "WindowCell_") + std::to_string(i);
+    G4double halfThickness = 0.5 * (edges[i + 1] - edges[i]);
+    auto solid = new G4Box(name, halfXY, halfXY, halfThickness);
+    auto logical = new G4LogicalVolume(solid, nullptr, name);
+    G4ThreeVector pos(0, 0, edges[i] + halfThickness);
+    fCells.push_back(new G4PVPlacement(nullptr, pos, logical, name, worldLogical, false,
+                                       static_cast<G4int>(i)));
+  }
+
+  G4cout << (fMode == kImportance ? "Importance" : "Weight-window") << " cells: " << nSlabs << " slabs from z = " << frontZ / cm << " to "
+         << backZ / cm << " cm" << G4endl;
+  FillStore();
+}
+
+void ImportanceGeometry::ReleaseCells()
+{
+  fCells.clear();
+  fGhostWorld = nullptr;
+}
+
+void ImportanceGeometry::SetNumberOfSlabs(G4int nSlabs)
+{
+  fImportances.assign(nSlabs, 1.);
+  fWindows = WeightWindowMesh::MakeDefault(GetNumberOfCells(), fWindows.groups);
+  SetRatio(2.);
+}
+
+void ImportanceGeometry::SetRatio(G4double ratio)
+{
+  for (std::size_t i = 0; i < fImportances.size(); ++i) {
+    fImportances[i] = std::pow(ratio, static_cast<G4double>(i));
+  }
+  FillStore();
+}
+
+void ImportanceGeometry::SetImportance(G4int slab, G4double importance)
+{
+  if (slab < 0 || slab >= static_cast<G4int>(fImportances.size())) {
+    G4ExceptionDescription msg;
+    msg << "No importance slab " << slab << "; there are " << fImportances.size() << ".";
+    G4Exception("ImportanceGeometry::SetImportance()", "B1Bias0002", JustWarning, msg);
+    return;
+  }
+  fImportances[slab] = importance;
+  FillStore();
+}
+
+void ImportanceGeometry::SetWindowGroups(G4int nGroups)
+{
+  // Windows set while the cells are released reach the store in Construct()
+  EnergyBinning groups(EnergyBinning::kLogarithmic, nGroups, 1.e-5 * eV, 20. * MeV);
+  fWindows = WeightWindowMesh::MakeDefault(GetNumberOfCells(), groups);
+  FillStore();
+}
+
+void ImportanceGeometry::ReadWindows(const G4String& fileName)
+{
+  if (WeightWindowMesh::Read(fileName, GetNumberOfCells(), fWindows)) {
+    G4cout << "Weight windows read from " << fileName << ": " << GetNumberOfCells()
+           << " cells, " << fWindows.groups.GetDescription()
+           << (fCells.empty() ? "; applied when the cells are built" : "") << G4endl;
+    FillStore();
+  }
+}
+
+void ImportanceGeometry::FillStore() const
+{
+  if (fCells.empty()) return;  // before the first construction, or released
+
+  if (fMode == kWeightWindow) {
+    // Energies above the last boundary use the last group
+    const auto& edges = fWindows.groups.GetEdges();
+    std::set<G4double, std::less<G4double>> upperBounds(edges.begin() + 1, edges.end() - 1);
+    upperBounds.insert(DBL_MAX);
+
+    G4WeightWindowStore* store = G4WeightWindowStore::GetInstance(GetName());
+    store->Clear();
+    store->SetParallelWorldVolume(GetName());
+    store->SetGeneralUpperEnergyBounds(upperBounds);
+    G4int nGroups = fWindows.groups.GetNumberOfBins();
+    auto cellWeights = [this, nGroups](G4int cell) {
+      auto first = fWindows.lowerWeights.begin() + cell * nGroups;
+      return std::vector<G4double>(first, first + nGroups);
+    };
+    store->AddLowerWeights(G4GeometryCell(*fGhostWorld, 0), cellWeights(0));
+    for (std::size_t i = 0; i < fCells.size(); ++i) {
+      G4int cell = static_cast<G4int>(i);
+      store->AddLowerWeights(G4GeometryCell(*fCells[i], cell), cellWeights(cell));
+    }
+    return;
+  }
+
+  // Cells of earlier constructions may have been deleted
+  G4IStore* store = G4IStore::GetInstance(GetName());
+  store->Clear();
+  store->SetParallelWorldVolume(GetName());
+  store->AddImportanceGeometryCell(1., *fGhostWorld);
+  store->AddImportanceGeometryCell(1., *fCells.front(), 0);
+  G4int nSlabs = static_cast<G4int>(fImportances.size());
+  for (G4int i = 0; i < nSlabs; ++i) {
+    store->AddImportanceGeometryCell(fImportances[i], *fCells[i + 1], i + 1);
+  }
+  store->AddImportanceGeometryCell(fImportances.back(), *fCells.back(), nSlabs + 1);
+}
+
+ImportanceMessenger::ImportanceMessenger(ImportanceGeometry* geometry)
+  : fGeometry(geometry)
+{
+  fDirectory = new G4UIdirectory("/B1/importance/");
+  fDirectory->SetGuidance("Cells behind the first wall for -b importance and -b weightwindow.");
+
+  fNSlabsCmd = new G4UIcmdWithAnInteger("/B1/importance/nSlabs", this);
+  fNSlabsCmd->SetGuidance("Number of equal slabs from the first layer behind the first wall");
+  fNSlabsCmd->SetGuidance("to the back of the blanket; resets the importances to 2^i");
+  fNSlabsCmd->SetGuidance("and the weight windows to weight 1.");
+  fNSlabsCmd->SetParameterName("nSlabs", false);
+  fNSlabsCmd->SetRange("nSlabs>0");
+  fNSlabsCmd->AvailableForStates(G4State_PreInit);
+  fNSlabsCmd->SetToBeBroadcasted(false);
+
+  fWindowDirectory = new G4UIdirectory("/B1/ww/");
+  fWindowDirectory->SetGuidance("Weight windows on the z cells and energy groups.");
+
+  fGroupsCmd = new G4UIcmdWithAnInteger("/B1/ww/groups", this);
+  fGroupsCmd->SetGuidance("Number of logarithmic window groups from 1e-5 eV to 20 MeV;");
+  fGroupsCmd->SetGuidance("resets the windows to weight 1.");
+  fGroupsCmd->SetParameterName("nGroups", false);
+  fGroupsCmd->SetRange("nGroups>0");
+  fGroupsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fGroupsCmd->SetToBeBroadcasted(false);
+
+  fGenerateCmd = new G4UIcmdWithAString("/B1/ww/generate", this);
+  fGenerateCmd->SetGuidance("Score the neutron flux on the cells and groups and write");
+  fGenerateCmd->SetGuidance("weight windows to this file at the end of every run;");
+  fGenerateCmd->SetGuidance("none to stop.");
+  fGenerateCmd->SetParameterName("fileName", false);
+  fGenerateCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fGenerateCmd->SetToBeBroadcasted(false);
+
+  if (geometry->GetMode() == ImportanceGeometry::kWeightWindow) {
+    fReadCmd = new G4UIcmdWithAString("/B1/ww/read", this);
+    fReadCmd->SetGuidance("Apply the weight windows of a file written by /B1/ww/generate;");
+    fReadCmd->SetGuidance("after a geometry change, from the next run on.");
+    fReadCmd->SetParameterName("fileName", false);
+    fReadCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+    fReadCmd->SetToBeBroadcasted(false);
+    return;
+  }
+
+  fRatioCmd = new G4UIcmdWithADouble("/B1/importance/ratio", this);
+  fRatioCmd->SetGuidance("Importance ratio between neighbouring slabs: slab i gets ratio^i.");
+  fRatioCmd->SetParameterName("ratio", false);
+  fRatioCmd->SetRange("ratio>0");
+  fRatioCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fRatioCmd->SetToBeBroadcasted(false);
+
+  fSetCmd = new G4UIcommand("/B1/importance/set", this);
+  fSetCmd->SetGuidance("Importance of one slab, counted from 0 at the front.");
+  auto slab = new G4UIparameter("slab", 'i', false);
+  slab->SetParameterRange("slab>=0");
+  fSetCmd->SetParameter(slab);
+  auto importance = new G4UIparameter("importance", 'd', false);
+  importance->SetParameterRange("importance>0");
+  fSetCmd->SetParameter(importance);
+  fSetCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fSetCmd->SetToBeBroadcasted(false);
+}
+
+ImportanceMessenger::~ImportanceMessenger()
+{
+  delete fReadCmd;
+  delete fGenerateCmd;
+  delete fGroupsCmd;
+  delete fWindowDirectory;
+  delete fSetCmd;
+  delete fRatioCmd;
+  delete fNSlabsCmd;
+  delete fDirectory;
+}
+
+void ImportanceMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fNSlabsCmd) {
+    fGeometry->SetNumberOfSlabs(fNSlabsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fRatioCmd) {
+    fGeometry->SetRatio(fRatioCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fSetCmd) {
+    std::istringstream is(newValue);
+    G4int slab;
+    G4double importance;
+    is >> slab >> importance;
+    fGeometry->SetImportance(slab, importance);
+  }
+  else if (command == fGroupsCmd) {
+    fGeometry->SetWindowGroups(fGroupsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fReadCmd) {
+    fGeometry->ReadWindows(newValue);
+  }
+  else if (command == fGenerateCmd) {
+    fGeometry->SetWindowOutput(newValue == "none" ? G4String() : newValue);
+  }
+}
+
+}  // namespace B1
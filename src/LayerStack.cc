@@ -0,0 +1,445 @@
+/// \file B1/src/LayerStack.cc
+/// \brief Implementation of the B1::LayerStack class
+
+#include "LayerStack.hh"
+
+#include "G4Element.hh"
+#include "G4Isotope.hh"
+#include "G4Material.hh"
+#include "G4NistManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UIcommand.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace B1
+{
+
+namespace
+{
+
+// One directive: positional words and key=value options
+struct Directive
+{
+  G4String fileName;
+  G4int lineNumber = 0;
+  std::vector<G4String> words;
+  std::map<G4String, G4String> options;
+};
+
+void SyntaxError(const Directive& directive, const G4String& what)
+{
+  G4ExceptionDescription msg;
+  msg << directive.fileName << ":" << directive.lineNumber << ": " << what;
+  G4Exception("LayerStack::Read()", "B1Geo0002", FatalException, msg);
+}
+
+G4double Number(const Directive& directive, std::size_t i)
+{
+  if (i >= directive.words.size()) {
+    SyntaxError(directive, "missing value after '" + directive.words[i - 1] + "'.");
+    return 0.;
+  }
+  std::istringstream is(directive.words[i]);
+  G4double value = 0.;
+  if (!(is >> value) || !is.eof()) {
+    SyntaxError(directive, "'" + directive.words[i] + "' is not a number.");
+  }
+  return value;
+}
+
+// Value at word i and unit at word i + 1
+G4double Quantity(const Directive& directive, std::size_t i)
+{
+  G4double value = Number(directive, i);
+  if (i + 1 >= directive.words.size()) {
+    SyntaxError(directive, "missing unit after '" + directive.words[i] + "'.");
+    return 0.;
+  }
+  G4double unit = G4UIcommand::ValueOf(directive.words[i + 1]);
+  if (unit <= 0.) {
+    SyntaxError(directive, "unknown unit '" + directive.words[i + 1] + "'.");
+  }
+  return value * unit;
+}
+
+G4double Enrichment(const Directive& directive)
+{
+  auto it = directive.options.find("enrich");
+  if (it == directive.options.end()) return -1.;
+  std::istringstream is(it->second);
+  G4double percent = -1.;
+  if (!(is >> percent) || percent < 0. || percent > 100.) {
+    SyntaxError(directive, "enrich must be a Li-6 atom percentage.");
+  }
+  return percent * perCent;
+}
+
+void ReadColour(const Directive& directive, LayerStack::Layer& layer)
+{
+  auto it = directive.options.find("colour");
+  if (it == directive.options.end()) return;
+  G4String values = it->second;
+  std::replace(values.begin(), values.end(), ',', ' ');
+  std::istringstream is(values);
+  G4double r = 0., g = 0., b = 0., a = 1.;
+  if (!(is >> r >> g >> b)) {
+    SyntaxError(directive, "colour must be r,g,b or r,g,b,a.");
+  }
+  is >> a;
+  layer.colour = G4Colour(r, g, b, a);
+  layer.hasColour = true;
+}
+
+VolumeRegistry::VolumeKind Kind(const Directive& directive, const G4String& name)
+{
+  static const std::map<G4String, VolumeRegistry::VolumeKind> kinds = {
+    {"firstwall", VolumeRegistry::kFirstWall},
+    {"multiplier", VolumeRegistry::kMultiplier},
+    {"breeder", VolumeRegistry::kBreeder},
+    {"backplate", VolumeRegistry::kBackPlate},
+    {"structure", VolumeRegistry::kStructure}};
+  auto it = kinds.find(name);
+  if (it == kinds.end()) {
+    SyntaxError(directive, "unknown layer kind '" + name + "'.");
+    return VolumeRegistry::kStructure;
+  }
+  return it->second;
+}
+
+G4double Thickness(const LayerStack::Layer& layer)
+{
+  if (layer.layers.empty()) return layer.thickness;
+  G4double thickness = 0.;
+  for (const auto& content : layer.layers) {
+    thickness += Thickness(content);
+  }
+  return thickness;
+}
+
+// Layer or material name; a trailing '*' matches any suffix
+G4bool Matches(const G4String& pattern, const G4String& name)
+{
+  if (!pattern.empty() && pattern.back() == '*') {
+    return name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0;
+  }
+  return name == pattern;
+}
+
+// thickness <layer> <value> <unit> or enrich <layer|material> <Li-6 at.%>,
+// applied once all layers are known; returns the number of layers changed
+G4int ApplyOverride(const Directive& directive, std::vector<LayerStack::Layer>& layers)
+{
+  const G4String& keyword = directive.words[0];
+  const G4String& pattern = directive.words[1];
+  G4int changed = 0;
+  for (auto& layer : layers) {
+    if (!layer.layers.empty()) {
+      if (keyword == "thickness" && Matches(pattern, layer.name)) {
+        SyntaxError(directive, "the thickness of container " + layer.name
+                                 + " follows from its contents.");
+      }
+      changed += ApplyOverride(directive, layer.layers);
+    }
+    else if (keyword == "thickness" && Matches(pattern, layer.name)) {
+      layer.thickness = Quantity(directive, 2);
+      if (layer.thickness <= 0.) {
+        SyntaxError(directive, "layer thickness must be positive.");
+      }
+      ++changed;
+    }
+    else if (keyword == "enrich"
+             && (Matches(pattern, layer.name) || Matches(pattern, layer.material)))
+    {
+      G4double percent = Number(directive, 2);
+      if (percent < 0. || percent > 100.) {
+        SyntaxError(directive, "enrich must be a Li-6 atom percentage.");
+      }
+      layer.enrichment = percent * perCent;
+      ++changed;
+    }
+  }
+  return changed;
+}
+
+// Container thicknesses after the overrides
+void UpdateThickness(LayerStack::Layer& layer)
+{
+  if (layer.layers.empty()) return;
+  for (auto& content : layer.layers) {
+    UpdateThickness(content);
+  }
+  layer.thickness = Thickness(layer);
+}
+
+// Li-6/Li-7 mixture with the given Li-6 atom fraction, shared by all materials
+G4Element* EnrichedLithium(G4double fraction)
+{
+  std::ostringstream name;
+  name << "Lithium_Li6_" << fraction / perCent;
+  if (auto element = G4Element::GetElement(name.str(), false)) return element;
+
+  G4Isotope* li6 = G4Isotope::GetIsotope("Li6", false);
+  if (!li6) li6 = new G4Isotope("Li6", 3, 6, 6.015 * g / mole);
+  G4Isotope* li7 = G4Isotope::GetIsotope("Li7", false);
+  if (!li7) li7 = new G4Isotope("Li7", 3, 7, 7.016 * g / mole);
+
+  auto element = new G4Element(name.str(), "Li", 2);
+  element->AddIsotope(li6, fraction);
+  element->AddIsotope(li7, 1. - fraction);
+  return element;
+}
+
+}  // namespace
+
+LayerStack LayerStack::Read(const G4String& fileName, const std::vector<G4String>& overrides)
+{
+  LayerStack stack;
+  stack.fFileName = fileName;
+
+  std::ifstream in(fileName);
+  if (!in.is_open()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open layer stack file " << fileName << ".";
+    G4Exception("LayerStack::Read()", "B1Geo0001", FatalException, msg);
+    return stack;
+  }
+
+  // File lines first, then the overrides given by the caller
+  struct Line
+  {
+    G4String source;
+    G4int number;
+    std::string text;
+  };
+  std::vector<Line> lines;
+  std::string text;
+  while (std::getline(in, text)) {
+    lines.push_back({fileName, static_cast<G4int>(lines.size()) + 1, text});
+  }
+  for (std::size_t i = 0; i < overrides.size(); ++i) {
+    lines.push_back({"override", static_cast<G4int>(i) + 1, overrides[i]});
+  }
+
+  // Containers being filled, innermost last; overrides wait for all layers
+  std::vector<Layer> open;
+  std::vector<Directive> pending;
+
+  Directive directive;
+  for (const auto& [source, number, line] : lines) {
+    directive.fileName = source;
+    directive.lineNumber = number;
+    directive.words.clear();
+    directive.options.clear();
+    std::istringstream is(line.substr(0, line.find('#')));
+    std::string word;
+    while (is >> word) {
+      auto equal = word.find('=');
+      if (equal != std::string::npos) {
+        directive.options[word.substr(0, equal)] = word.substr(equal + 1);
+      }
+      else {
+        directive.words.push_back(word);
+      }
+    }
+    if (directive.words.empty()) continue;
+
+    const G4String& keyword = directive.words[0];
+    const auto& words = directive.words;
+    if (keyword == "world" && words.size() == 3) {
+      stack.fWorldMaterial = words[1];
+      stack.fWorldMargin = Number(directive, 2);
+    }
+    else if (keyword == "envelope" && words.size() == 6) {
+      stack.fEnvelopeMaterial = words[1];
+      stack.fEnvelopeXY = Quantity(directive, 2);
+      stack.fEnvelopeZ = Quantity(directive, 4);
+    }
+    else if (keyword == "layer_xy" && words.size() == 3) {
+      stack.fLayerXY = Quantity(directive, 1);
+    }
+    else if (keyword == "front_z" && words.size() == 3) {
+      stack.fFrontZ = Quantity(directive, 1);
+    }
+    else if (keyword == "depth_origin" && words.size() == 3) {
+      stack.fDepthOrigin = Quantity(directive, 1);
+      stack.fHasDepthOrigin = true;
+    }
+    else if (keyword == "source_z" && words.size() == 3) {
+      stack.fSourceZ = Quantity(directive, 1);
+      stack.fHasSourceZ = true;
+    }
+    else if (keyword == "material" && words.size() >= 7 && words.size() % 2 == 1) {
+      Material material;
+      material.name = words[1];
+      material.density = Quantity(directive, 2);
+      if (words[4] != "mass" && words[4] != "atoms") {
+        SyntaxError(directive, "composition must be given by 'mass' or 'atoms'.");
+      }
+      material.byMass = (words[4] == "mass");
+      for (std::size_t i = 5; i < words.size(); i += 2) {
+        material.components.emplace_back(words[i], Number(directive, i + 1));
+      }
+      material.enrichment = Enrichment(directive);
+      stack.fMaterials.push_back(std::move(material));
+    }
+    else if (keyword == "layer" && words.size() == 6) {
+      Layer layer;
+      layer.name = words[1];
+      layer.kind = Kind(directive, words[2]);
+      layer.material = words[3];
+      layer.thickness = Quantity(directive, 4);
+      if (layer.thickness <= 0.) {
+        SyntaxError(directive, "layer thickness must be positive.");
+      }
+      if (directive.options.count("seg") > 0) {
+        layer.segments = std::atoi(directive.options["seg"].c_str());
+        if (layer.segments < 1) {
+          SyntaxError(directive, "seg must be a positive number of slabs.");
+        }
+      }
+      layer.enrichment = Enrichment(directive);
+      ReadColour(directive, layer);
+      (open.empty() ? stack.fLayers : open.back().layers).push_back(std::move(layer));
+    }
+    else if (keyword == "container" && words.size() == 3) {
+      Layer container;
+      container.name = words[1];
+      container.kind = VolumeRegistry::kContainer;
+      container.material = words[2];
+      ReadColour(directive, container);
+      open.push_back(std::move(container));
+    }
+    else if (keyword == "end" && words.size() == 1 && !open.empty()) {
+      Layer container = std::move(open.back());
+      open.pop_back();
+      if (container.layers.empty()) {
+        SyntaxError(directive, "container " + container.name + " is empty.");
+      }
+      container.thickness = Thickness(container);
+      (open.empty() ? stack.fLayers : open.back().layers).push_back(std::move(container));
+    }
+    else if ((keyword == "thickness" && words.size() == 4)
+             || (keyword == "enrich" && words.size() == 3))
+    {
+      pending.push_back(directive);
+    }
+    else {
+      SyntaxError(directive, "cannot parse '" + line + "'.");
+    }
+  }
+
+  if (!open.empty()) {
+    SyntaxError(directive, "container " + open.back().name + " is not closed by 'end'.");
+  }
+  for (const auto& change : pending) {
+    if (ApplyOverride(change, stack.fLayers) == 0) {
+      SyntaxError(change, "'" + change.words[1] + "' matches no layer.");
+    }
+  }
+  for (auto& layer : stack.fLayers) {
+    UpdateThickness(layer);
+  }
+  if (!stack.fHasDepthOrigin) {
+    stack.fDepthOrigin = stack.fFrontZ;
+  }
+  if (!stack.fHasSourceZ) {
+    stack.fSourceZ = -0.5 * stack.fEnvelopeZ;
+  }
+  stack.Check();
+  return stack;
+}
+
+void LayerStack::Check() const
+{
+  std::ostringstream os;
+  if (fLayers.empty()) {
+    os << "no layers defined.";
+  }
+  else if (fEnvelopeXY <= 0. || fEnvelopeZ <= 0. || fLayerXY <= 0. || fWorldMargin < 1.) {
+    os << "envelope, layer_xy and a world margin >= 1 must be given.";
+  }
+  else if (fLayerXY > fEnvelopeXY) {
+    os << "layers (" << fLayerXY / cm << " cm) wider than the envelope ("
+       << fEnvelopeXY / cm << " cm).";
+  }
+  else if (fFrontZ < -0.5 * fEnvelopeZ || fFrontZ + GetThickness() > 0.5 * fEnvelopeZ) {
+    os << "stack from z = " << fFrontZ / cm << " cm to " << (fFrontZ + GetThickness()) / cm
+       << " cm does not fit in the " << fEnvelopeZ / cm << " cm envelope.";
+  }
+  else {
+    return;
+  }
+
+  G4ExceptionDescription msg;
+  msg << fFileName << ": " << os.str();
+  G4Exception("LayerStack::Check()", "B1Geo0003", FatalException, msg);
+}
+
+G4double LayerStack::GetThickness() const
+{
+  G4double thickness = 0.;
+  for (const auto& layer : fLayers) {
+    thickness += Thickness(layer);
+  }
+  return thickness;
+}
+
+G4Material* LayerStack::GetMaterial(const G4String& name, G4double enrichment) const
+{
+  auto spec = std::find_if(fMaterials.begin(), fMaterials.end(),
+                           [&name](const Material& material) { return material.name == name; });
+  if (spec == fMaterials.end()) {
+    if (enrichment >= 0.) {
+      G4ExceptionDescription msg;
+      msg << "Enrichment of material " << name << " not defined in " << fFileName << ".";
+      G4Exception("LayerStack::GetMaterial()", "B1Geo0004", FatalException, msg);
+    }
+    G4Material* material = G4NistManager::Instance()->FindOrBuildMaterial(name);
+    if (!material) {
+      G4ExceptionDescription msg;
+      msg << "Unknown material " << name << " in " << fFileName << ".";
+      G4Exception("LayerStack::GetMaterial()", "B1Geo0004", FatalException, msg);
+    }
+    return material;
+  }
+
+  // Variants are named after the Li-6 fraction, so they are built only once
+  G4String materialName = name;
+  if (enrichment < 0. || enrichment == spec->enrichment) {
+    enrichment = spec->enrichment;
+  }
+  else {
+    std::ostringstream os;
+    os << name << "_Li6_" << enrichment / perCent;
+    materialName = os.str();
+  }
+  if (auto material = G4Material::GetMaterial(materialName, false)) return material;
+
+  G4NistManager* nist = G4NistManager::Instance();
+  auto material = new G4Material(materialName, spec->density,
+                                 static_cast<G4int>(spec->components.size()));
+  for (const auto& [symbol, amount] : spec->components) {
+    G4Element* element = (symbol == "Li" && enrichment >= 0.) ? EnrichedLithium(enrichment)
+                                                              : nist->FindOrBuildElement(symbol);
+    if (!element) {
+      G4ExceptionDescription msg;
+      msg << "Unknown element " << symbol << " in material " << name << ".";
+      G4Exception("LayerStack::GetMaterial()", "B1Geo0004", FatalException, msg);
+      return nullptr;
+    }
+    if (spec->byMass) {
+      material->AddElement(element, amount);
+    }
+    else {
+      material->AddElement(element, static_cast<G4int>(amount));
+    }
+  }
+  return material;
+}
+
+}  // namespace B1
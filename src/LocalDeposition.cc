@@ -0,0 +1,84 @@
+/// \file B1/src/LocalDeposition.cc
+/// \brief Implementation of the B1::LocalDepositionProcess and B1::LocalDepositionPhysics classes
+
+#include "LocalDeposition.hh"
+#include "VolumeRegistry.hh"
+
+#include "G4Electron.hh"
+#include "G4Gamma.hh"
+#include "G4ProcessManager.hh"
+#include "G4Track.hh"
+#include "G4UnitsTable.hh"
+
+#include <algorithm>
+
+namespace B1
+{
+
+LocalDepositionProcess::LocalDepositionProcess(G4double threshold,
+                                               const VolumeRegistry* volumes,
+                                               const G4String& name)
+  : G4VDiscreteProcess(name, fGeneral),
+    fThreshold(threshold),
+    fVolumes(volumes)
+{}
+
+G4bool LocalDepositionProcess::IsApplicable(const G4ParticleDefinition& particle)
+{
+  return &particle == G4Gamma::Definition() || &particle == G4Electron::Definition();
+}
+
+G4double LocalDepositionProcess::PostStepGetPhysicalInteractionLength(const G4Track& track,
+                                                                      G4double,
+                                                                      G4ForceCondition* condition)
+{
+  // Zero step length below the threshold: the particle stops where it is.
+  // The geometry, and with it the photoneutron threshold, can change
+  // between runs
+  *condition = NotForced;
+  G4double threshold = std::min(fThreshold, fVolumes->GetPhotoNeutronThreshold());
+  return (track.GetKineticEnergy() < threshold) ? 0. : DBL_MAX;
+}
+
+G4VParticleChange* LocalDepositionProcess::PostStepDoIt(const G4Track& track, const G4Step&)
+{
+  aParticleChange.Initialize(track);
+  aParticleChange.ProposeLocalEnergyDeposit(track.GetKineticEnergy());
+  aParticleChange.ProposeEnergy(0.);
+  aParticleChange.ProposeTrackStatus(fStopAndKill);
+  return &aParticleChange;
+}
+
+LocalDepositionPhysics::LocalDepositionPhysics(const VolumeRegistry* volumes)
+  : G4VPhysicsConstructor("LocalDeposition"),
+    fVolumes(volumes)
+{}
+
+void LocalDepositionPhysics::ConstructParticle()
+{
+  G4Gamma::Definition();
+  G4Electron::Definition();
+}
+
+void LocalDepositionPhysics::ConstructProcess()
+{
+  // The geometry is built before the processes
+  G4double photoNeutronThreshold = fVolumes->GetPhotoNeutronThreshold();
+  if (std::max(fGammaThreshold, fElectronThreshold) > photoNeutronThreshold) {
+    G4ExceptionDescription msg;
+    msg << "Local deposition thresholds above the lowest (gamma,n) threshold of the geometry, "
+        << G4BestUnit(photoNeutronThreshold, "Energy") << ", are capped at it.";
+    G4Exception("LocalDepositionPhysics::ConstructProcess()", "B1Phys0001", JustWarning, msg);
+  }
+
+  if (fGammaThreshold > 0.) {
+    G4Gamma::Definition()->GetProcessManager()->AddDiscreteProcess(
+      new LocalDepositionProcess(fGammaThreshold, fVolumes, "gammaLocalDeposition"));
+  }
+  if (fElectronThreshold > 0.) {
+    G4Electron::Definition()->GetProcessManager()->AddDiscreteProcess(
+      new LocalDepositionProcess(fElectronThreshold, fVolumes, "eLocalDeposition"));
+  }
+}
+
+}  // namespace B1
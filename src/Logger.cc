@@ -0,0 +1,124 @@
+/// \file B1/src/Logger.cc
+/// \brief Implementation of the B1::Logger and B1::LoggerMessenger classes
+
+#include "Logger.hh"
+
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+namespace
+{
+// Messages printed by this thread in the current run, per channel
+G4ThreadLocal G4int printedCount[B1::Logger::kNumberOfChannels] = {0};
+
+const char* channelNames[B1::Logger::kNumberOfChannels] = {"TRITON", "HELIUM", "MULT", "EVENT"};
+}  // namespace
+
+namespace B1
+{
+
+std::atomic<G4int> Logger::fgLevel{Logger::kSecondary};
+std::atomic<G4int> Logger::fgFirstN{0};
+std::atomic<unsigned> Logger::fgChannels{~0u};
+
+G4bool Logger::ShouldLog(Channel channel, Level level)
+{
+  if (level > fgLevel.load(std::memory_order_relaxed)) return false;
+  if (!(fgChannels.load(std::memory_order_relaxed) & (1u << channel))) return false;
+
+  G4int firstN = fgFirstN.load(std::memory_order_relaxed);
+  if (firstN > 0) {
+    G4int count = printedCount[channel]++;
+    if (count == firstN) {
+      G4cout << "[" << channelNames[channel] << "] first " << firstN
+             << " messages printed, further ones suppressed in this run" << G4endl;
+    }
+    return count < firstN;
+  }
+  return true;
+}
+
+void Logger::SetChannel(Channel channel, G4bool enabled)
+{
+  if (enabled) {
+    fgChannels |= (1u << channel);
+  } else {
+    fgChannels &= ~(1u << channel);
+  }
+}
+
+void Logger::ResetCounters()
+{
+  for (auto& count : printedCount) {
+    count = 0;
+  }
+}
+
+const char* Logger::GetChannelName(Channel channel)
+{
+  return channelNames[channel];
+}
+
+LoggerMessenger::LoggerMessenger()
+{
+  fDirectory = new G4UIdirectory("/B1/log/");
+  fDirectory->SetGuidance("Diagnostic console output ([TRITON], [HELIUM], [MULT], [EVENT]).");
+
+  fLevelCmd = new G4UIcmdWithAnInteger("/B1/log/level", this);
+  fLevelCmd->SetGuidance("0: quiet, 1: per-event summaries, 2: per-secondary messages.");
+  fLevelCmd->SetParameterName("level", false);
+  fLevelCmd->SetRange("level>=0 && level<=2");
+  fLevelCmd->SetToBeBroadcasted(false);
+
+  fFirstNCmd = new G4UIcmdWithAnInteger("/B1/log/firstN", this);
+  fFirstNCmd->SetGuidance("Print only the first N messages per channel, thread and run.");
+  fFirstNCmd->SetGuidance("0 disables the limit.");
+  fFirstNCmd->SetParameterName("N", false);
+  fFirstNCmd->SetRange("N>=0");
+  fFirstNCmd->SetToBeBroadcasted(false);
+
+  fChannelCmd = new G4UIcommand("/B1/log/channel", this);
+  fChannelCmd->SetGuidance("Enable or disable one channel.");
+  auto channel = new G4UIparameter("channel", 's', false);
+  channel->SetParameterCandidates("TRITON HELIUM MULT EVENT");
+  fChannelCmd->SetParameter(channel);
+  auto enabled = new G4UIparameter("enabled", 'b', true);
+  enabled->SetDefaultValue("true");
+  fChannelCmd->SetParameter(enabled);
+  fChannelCmd->SetToBeBroadcasted(false);
+}
+
+LoggerMessenger::~LoggerMessenger()
+{
+  delete fChannelCmd;
+  delete fFirstNCmd;
+  delete fLevelCmd;
+  delete fDirectory;
+}
+
+void LoggerMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fLevelCmd) {
+    Logger::SetLevel(fLevelCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fFirstNCmd) {
+    Logger::SetFirstN(fFirstNCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fChannelCmd) {
+    std::istringstream is(newValue);
+    G4String name, enabled;
+    is >> name >> enabled;
+    for (G4int i = 0; i < Logger::kNumberOfChannels; ++i) {
+      auto channel = static_cast<Logger::Channel>(i);
+      if (name == Logger::GetChannelName(channel)) {
+        Logger::SetChannel(channel, G4UIcommand::ConvertToBool(enabled));
+      }
+    }
+  }
+}
+
+}  // namespace B1
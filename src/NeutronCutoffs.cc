@@ -0,0 +1,142 @@
+/// \file B1/src/NeutronCutoffs.cc
+/// \brief Implementation of the B1::NeutronCutoffs and B1::CutoffMessenger classes
+
+#include "NeutronCutoffs.hh"
+
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcommand.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+#include "G4UnitsTable.hh"
+
+#include <sstream>
+
+namespace
+{
+// Region name, value and unit, e.g. "Structure 0.5 eV"
+G4UIcommand* MakeCutCommand(const G4String& path, G4UImessenger* messenger,
+                            const G4String& value, const G4String& unitCategory,
+                            const G4String& defaultUnit)
+{
+  auto command = new G4UIcommand(path, messenger);
+  auto region = new G4UIparameter("region", 's', false);
+  region->SetParameterCandidates("FirstWall Multiplier Breeder Structure World");
+  command->SetParameter(region);
+  auto number = new G4UIparameter(value, 'd', false);
+  number->SetParameterRange(value + ">=0");
+  command->SetParameter(number);
+  auto unit = new G4UIparameter("unit", 's', true);
+  unit->SetDefaultValue(defaultUnit);
+  unit->SetParameterCandidates(G4UIcommand::UnitsList(unitCategory));
+  command->SetParameter(unit);
+  command->AvailableForStates(G4State_PreInit, G4State_Idle);
+  return command;
+}
+}  // namespace
+
+namespace B1
+{
+
+NeutronCutoffs::NeutronCutoffs()
+{
+  fMessenger = new CutoffMessenger(this);
+}
+
+NeutronCutoffs::~NeutronCutoffs()
+{
+  delete fMessenger;
+}
+
+void NeutronCutoffs::Print(std::ostream& out) const
+{
+  out << "Neutron cutoffs (";
+  if (fMode == kRoulette) {
+    out << "roulette, survival " << fSurvival << "):";
+  }
+  else {
+    out << "kill):";
+  }
+  for (G4int zone = 0; zone <= BlanketRegions::kNumberOfZones; ++zone) {
+    if (fEnergyCuts[zone] > 0.) {
+      out << " " << BlanketRegions::GetZoneName(zone) << " E < "
+          << G4BestUnit(fEnergyCuts[zone], "Energy");
+    }
+    if (fTimeCuts[zone] < DBL_MAX) {
+      out << " " << BlanketRegions::GetZoneName(zone) << " t > "
+          << G4BestUnit(fTimeCuts[zone], "Time");
+    }
+  }
+  out << "\n";
+}
+
+CutoffMessenger::CutoffMessenger(NeutronCutoffs* cutoffs)
+  : fCutoffs(cutoffs)
+{
+  fDirectory = new G4UIdirectory("/B1/cutoff/");
+  fDirectory->SetGuidance("Neutron energy and time cutoffs per region; World is the world,");
+  fDirectory->SetGuidance("the envelope and the containers.");
+
+  fEnergyCmd = MakeCutCommand("/B1/cutoff/energy", this, "energy", "Energy", "eV");
+  fEnergyCmd->SetGuidance("Cut neutrons below this kinetic energy in one region;");
+  fEnergyCmd->SetGuidance("0 removes the cut.");
+
+  fTimeCmd = MakeCutCommand("/B1/cutoff/time", this, "time", "Time", "ns");
+  fTimeCmd->SetGuidance("Cut neutrons older than this global time in one region;");
+  fTimeCmd->SetGuidance("0 removes the cut.");
+
+  fModeCmd = new G4UIcmdWithAString("/B1/cutoff/mode", this);
+  fModeCmd->SetGuidance("kill: cut neutrons are killed and their weight lost; roulette: they");
+  fModeCmd->SetGuidance("survive with /B1/cutoff/survival, their weight raised to match.");
+  fModeCmd->SetParameterName("mode", false);
+  fModeCmd->SetCandidates("kill roulette");
+  fModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSurvivalCmd = new G4UIcmdWithADouble("/B1/cutoff/survival", this);
+  fSurvivalCmd->SetGuidance("Survival probability of the roulette at the cutoffs.");
+  fSurvivalCmd->SetParameterName("p", false);
+  fSurvivalCmd->SetRange("p>0 && p<=1");
+  fSurvivalCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+CutoffMessenger::~CutoffMessenger()
+{
+  delete fSurvivalCmd;
+  delete fModeCmd;
+  delete fTimeCmd;
+  delete fEnergyCmd;
+  delete fDirectory;
+}
+
+void CutoffMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fModeCmd) {
+    fCutoffs->SetMode(newValue == "roulette" ? NeutronCutoffs::kRoulette : NeutronCutoffs::kKill);
+    return;
+  }
+  if (command == fSurvivalCmd) {
+    fCutoffs->SetSurvivalProbability(G4UIcmdWithADouble::GetNewDoubleValue(newValue));
+    return;
+  }
+
+  std::istringstream is(newValue);
+  G4String name, unit;
+  G4double value = 0.;
+  is >> name >> value >> unit;
+  value *= G4UIcommand::ValueOf(unit);
+
+  G4int zone = -1;
+  for (G4int i = 0; i <= BlanketRegions::kNumberOfZones; ++i) {
+    if (name == BlanketRegions::GetZoneName(i)) zone = i;
+  }
+  if (zone < 0) return;  // excluded by the candidates
+
+  if (command == fEnergyCmd) {
+    fCutoffs->SetEnergyCut(zone, value);
+  }
+  else if (command == fTimeCmd) {
+    fCutoffs->SetTimeCut(zone, value);
+  }
+}
+
+}  // namespace B1
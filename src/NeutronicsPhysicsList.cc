@@ -0,0 +1,149 @@
+/// \file B1/src/NeutronicsPhysicsList.cc
+/// \brief Implementation of the B1::NeutronicsPhysicsList and B1::NeutronicsPhysicsMessenger classes
+
+#include "NeutronicsPhysicsList.hh"
+#include "LocalDeposition.hh"
+
+#include "G4DecayPhysics.hh"
+#include "G4EmExtraPhysics.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4EmStandardPhysics_option1.hh"
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4HadronElasticPhysicsHP.hh"
+#include "G4HadronPhysicsQGSP_BIC_HP.hh"
+#include "G4IonPhysics.hh"
+#include "G4NeutronTrackingCut.hh"
+#include "G4StoppingPhysics.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIdirectory.hh"
+
+namespace
+{
+G4VPhysicsConstructor* MakeEmPhysics(const G4String& option)
+{
+  if (option == "fast") return new G4EmStandardPhysics_option1();
+  if (option == "accurate") return new G4EmStandardPhysics_option4();
+  return new G4EmStandardPhysics();
+}
+}  // namespace
+
+namespace B1
+{
+
+NeutronicsPhysicsList::NeutronicsPhysicsList(const VolumeRegistry* volumes)
+{
+  SetVerboseLevel(1);
+
+  RegisterPhysics(MakeEmPhysics(fEmOption));
+  fEmExtra = new G4EmExtraPhysics();
+  RegisterPhysics(fEmExtra);
+  RegisterPhysics(new G4DecayPhysics());
+  RegisterPhysics(new G4HadronElasticPhysicsHP());
+  RegisterPhysics(new G4HadronPhysicsQGSP_BIC_HP());
+  RegisterPhysics(new G4StoppingPhysics());
+  RegisterPhysics(new G4IonPhysics());
+  RegisterPhysics(new G4NeutronTrackingCut());
+
+  fLocalDeposition = new LocalDepositionPhysics(volumes);
+  RegisterPhysics(fLocalDeposition);
+
+  fMessenger = new NeutronicsPhysicsMessenger(this);
+}
+
+NeutronicsPhysicsList::~NeutronicsPhysicsList()
+{
+  delete fMessenger;
+}
+
+void NeutronicsPhysicsList::SetEmOption(const G4String& option)
+{
+  if (option == fEmOption) return;
+  fEmOption = option;
+  // Same physics type, so the EM constructor is swapped in place
+  ReplacePhysics(MakeEmPhysics(option));
+}
+
+void NeutronicsPhysicsList::SetGammaLocalDeposit(G4double energy)
+{
+  fLocalDeposition->SetGammaThreshold(energy);
+}
+
+void NeutronicsPhysicsList::SetElectronLocalDeposit(G4double energy)
+{
+  fLocalDeposition->SetElectronThreshold(energy);
+}
+
+void NeutronicsPhysicsList::SetPhotoNuclear(G4bool enable)
+{
+  fEmExtra->GammaNuclear(enable);
+  fEmExtra->ElectroNuclear(enable);
+}
+
+NeutronicsPhysicsMessenger::NeutronicsPhysicsMessenger(NeutronicsPhysicsList* physicsList)
+  : fPhysicsList(physicsList)
+{
+  fDirectory = new G4UIdirectory("/B1/physics/");
+  fDirectory->SetGuidance("Options of the neutronics physics list (exampleB1 -p neutronics).");
+
+  fEmCmd = new G4UIcmdWithAString("/B1/physics/em", this);
+  fEmCmd->SetGuidance("EM fidelity: fast (option1), standard (as QGSP_BIC_HP), accurate (option4).");
+  fEmCmd->SetParameterName("option", false);
+  fEmCmd->SetCandidates("fast standard accurate");
+  fEmCmd->AvailableForStates(G4State_PreInit);
+  fEmCmd->SetToBeBroadcasted(false);
+
+  fGammaLocalCmd = new G4UIcmdWithADoubleAndUnit("/B1/physics/gammaLocalDeposit", this);
+  fGammaLocalCmd->SetGuidance("Deposit photons below this energy on the spot; 0 disables.");
+  fGammaLocalCmd->SetGuidance("Capped at the lowest (gamma,n) threshold of the geometry.");
+  fGammaLocalCmd->SetParameterName("energy", false);
+  fGammaLocalCmd->SetRange("energy>=0");
+  fGammaLocalCmd->SetUnitCategory("Energy");
+  fGammaLocalCmd->AvailableForStates(G4State_PreInit);
+  fGammaLocalCmd->SetToBeBroadcasted(false);
+
+  fElectronLocalCmd = new G4UIcmdWithADoubleAndUnit("/B1/physics/electronLocalDeposit", this);
+  fElectronLocalCmd->SetGuidance("Deposit electrons below this energy on the spot; 0 disables.");
+  fElectronLocalCmd->SetGuidance("Positrons are always transported, for their annihilation.");
+  fElectronLocalCmd->SetGuidance("Capped at the lowest (gamma,n) threshold of the geometry.");
+  fElectronLocalCmd->SetParameterName("energy", false);
+  fElectronLocalCmd->SetRange("energy>=0");
+  fElectronLocalCmd->SetUnitCategory("Energy");
+  fElectronLocalCmd->AvailableForStates(G4State_PreInit);
+  fElectronLocalCmd->SetToBeBroadcasted(false);
+
+  fPhotoNuclearCmd = new G4UIcmdWithABool("/B1/physics/photoNuclear", this);
+  fPhotoNuclearCmd->SetGuidance("Gamma- and electro-nuclear reactions, on as in QGSP_BIC_HP.");
+  fPhotoNuclearCmd->SetGuidance("Off removes the (gamma,n) photoneutrons, e.g. from Be-9.");
+  fPhotoNuclearCmd->SetParameterName("enable", false);
+  fPhotoNuclearCmd->AvailableForStates(G4State_PreInit);
+  fPhotoNuclearCmd->SetToBeBroadcasted(false);
+}
+
+NeutronicsPhysicsMessenger::~NeutronicsPhysicsMessenger()
+{
+  delete fPhotoNuclearCmd;
+  delete fElectronLocalCmd;
+  delete fGammaLocalCmd;
+  delete fEmCmd;
+  delete fDirectory;
+}
+
+void NeutronicsPhysicsMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fEmCmd) {
+    fPhysicsList->SetEmOption(newValue);
+  }
+  else if (command == fGammaLocalCmd) {
+    fPhysicsList->SetGammaLocalDeposit(fGammaLocalCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fElectronLocalCmd) {
+    fPhysicsList->SetElectronLocalDeposit(fElectronLocalCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fPhotoNuclearCmd) {
+    fPhysicsList->SetPhotoNuclear(G4UIcmdWithABool::GetNewBoolValue(newValue));
+  }
+}
+
+}  // namespace B1
@@ -0,0 +1,88 @@
+/// \file B1/src/OutputSink.cc
+/// \brief Implementation of the B1::OutputSink class
+
+#include "OutputSink.hh"
+
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+
+namespace
+{
+// Part files written during the current run, per quantity
+G4Mutex partsMutex = G4MUTEX_INITIALIZER;
+std::map<G4String, std::vector<G4String>> partFiles;
+
+G4String RunFileName(const G4String& quantity, G4int runID)
+{
+  return quantity + "_run" + std::to_string(runID);
+}
+}  // namespace
+
+namespace B1
+{
+
+OutputSink::OutputSink(const G4String& quantity)
+  : fQuantity(quantity)
+{}
+
+OutputSink::~OutputSink()
+{
+  Close();
+}
+
+void OutputSink::Open(G4int runID)
+{
+  Close();
+
+  // The master has thread ID -1 (sequential mode)
+  G4String fileName = RunFileName(fQuantity, runID) + ".part"
+                      + std::to_string(G4Threading::G4GetThreadId() + 1) + ".txt";
+
+  // The buffer must be installed before the file is opened
+  fBuffer.resize(kBufferSize);
+  fFile.rdbuf()->pubsetbuf(fBuffer.data(), fBuffer.size());
+  fFile.open(fileName, std::ios::trunc);
+  if (!fFile.is_open()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open " << fileName << " for writing.";
+    G4Exception("OutputSink::Open()", "B1Out0001", FatalException, msg);
+    return;
+  }
+
+  G4AutoLock lock(&partsMutex);
+  partFiles[fQuantity].push_back(fileName);
+}
+
+void OutputSink::Close()
+{
+  if (fFile.is_open()) {
+    fFile.close();
+  }
+}
+
+void OutputSink::Consolidate(const G4String& quantity, G4int runID)
+{
+  std::vector<G4String> parts;
+  {
+    G4AutoLock lock(&partsMutex);
+    parts.swap(partFiles[quantity]);
+  }
+  std::sort(parts.begin(), parts.end());
+
+  G4String fileName = RunFileName(quantity, runID) + ".txt";
+  std::ofstream out(fileName, std::ios::trunc | std::ios::binary);
+  for (const auto& part : parts) {
+    std::ifstream in(part, std::ios::binary);
+    if (in.peek() != std::ifstream::traits_type::eof()) {
+      out << in.rdbuf();
+    }
+    in.close();
+    std::remove(part.c_str());
+  }
+}
+
+}  // namespace B1
@@ -2,10 +2,8 @@
 /// \brief Implementation of the B1::PrimaryGeneratorAction class
 
 #include "PrimaryGeneratorAction.hh"
+#include "VolumeRegistry.hh"
 
-#include "G4Box.hh"
-#include "G4LogicalVolume.hh"
-#include "G4LogicalVolumeStore.hh"
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
 #include "G4SystemOfUnits.hh"
@@ -14,7 +12,8 @@
 namespace B1
 {
 
-PrimaryGeneratorAction::PrimaryGeneratorAction()
+PrimaryGeneratorAction::PrimaryGeneratorAction(const VolumeRegistry* volumes)
+  : fVolumes(volumes)
 {
   G4int n_particle = 1;
   fParticleGun = new G4ParticleGun(n_particle);
@@ -34,25 +33,9 @@ PrimaryGeneratorAction::~PrimaryGeneratorAction()
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
 {
-  // Get the envelope volume
-  G4double envSizeXY = 0;
-  G4double envSizeZ = 0;
-
-  if (!fEnvelopeBox) {
-    G4LogicalVolume* envLV = G4LogicalVolumeStore::GetInstance()->GetVolume("Envelope");
-    if (envLV) fEnvelopeBox = dynamic_cast<G4Box*>(envLV->GetSolid());
-  }
-
-  if (fEnvelopeBox) {
-    envSizeXY = fEnvelopeBox->GetXHalfLength() * 2.;
-    envSizeZ = fEnvelopeBox->GetZHalfLength() * 2.;
-  } else {
-    G4ExceptionDescription msg;
-    msg << "Envelope volume of box shape not found.\n";
-    msg << "Perhaps you have changed geometry.\n";
-    msg << "The gun will be placed at the center.";
-    G4Exception("PrimaryGeneratorAction::GeneratePrimaries()", "MyCode0002", JustWarning, msg);
-  }
+  // Envelope width and source plane of the current geometry; the registry
+  // is refilled whenever the geometry is rebuilt
+  G4double envSizeXY = fVolumes->GetSourceWidth();
 
   // Generate a Gaussian-distributed energy (centered at 14 MeV, sigma = 0.5 MeV)
   G4double meanEnergy = 14.0 * MeV;
@@ -67,7 +50,7 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event)
   G4double size = 0.005;
   G4double x0 = size * envSizeXY * (G4UniformRand() - 0.5);
   G4double y0 = size * envSizeXY * (G4UniformRand() - 0.5);
-  G4double z0 = -0.5 * envSizeZ + 2.0 * cm;  
+  G4double z0 = fVolumes->GetSourceZ();  // from the layer stack
 
   fParticleGun->SetParticlePosition(G4ThreeVector(x0, y0, z0));
   fParticleGun->GeneratePrimaryVertex(event);
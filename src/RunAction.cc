@@ -0,0 +1,577 @@
+/// \file B1/src/RunAction.cc
+/// \brief Implementation of the B1::RunAction class
+
+#include "RunAction.hh"
+#include "RunMessenger.hh"
+#include "BlanketRegions.hh"
+#include "ConvergenceMonitor.hh"
+#include "CrossSectionBiasing.hh"
+#include "DetectorConstruction.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "EventAction.hh"
+#include "ImportanceGeometry.hh"
+#include "VolumeRegistry.hh"
+#include "Logger.hh"
+
+#include "G4AccumulableManager.hh"
+#include "G4Run.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+#include "G4Threading.hh"
+
+#include <fstream>
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+// Relative statistical error of a sum of nofEvents independent samples
+G4double RelativeError(G4double sum, G4double sum2, G4int nofEvents)
+{
+  if (sum == 0. || nofEvents < 2) return 0.;
+  G4double mean = sum / nofEvents;
+  G4double variance = (sum2 / nofEvents - mean * mean) / (nofEvents - 1);
+  return (variance > 0.) ? std::sqrt(variance) / std::abs(mean) : 0.;
+}
+}  // namespace
+
+namespace B1
+{
+
+RunAction::RunAction(const VolumeRegistry* volumes, const ImportanceGeometry* cells)
+  : fVolumes(volumes),
+    fCells(cells),
+    fSpectrumEMin(1.e-5 * eV),
+    fSpectrumEMax(20. * MeV)
+{
+  fMessenger = new RunMessenger(this);
+
+  fSinks.reserve(kNumberOfSinks);
+  fSinks.emplace_back("triton_depth");
+  fSinks.emplace_back("alpha_depth");
+  fSinks.emplace_back("neutron_multiplication_depth");
+
+  // Define custom units for dose (optional)
+  new G4UnitDefinition("milligray", "milliGy", "Dose", 1.e-3 * gray);
+  new G4UnitDefinition("microgray", "microGy", "Dose", 1.e-6 * gray);
+  new G4UnitDefinition("nanogray", "nanoGy", "Dose", 1.e-9 * gray);
+  new G4UnitDefinition("picogray", "picoGy", "Dose", 1.e-12 * gray);
+
+  // Register accumulables
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->Register(fEdep);
+  accumulableManager->Register(fEdep2);
+  accumulableManager->Register(fTritiumTotal);
+  accumulableManager->Register(fHeliumTotal);
+  accumulableManager->Register(fMultiplicationTotal);
+  accumulableManager->Register(fEffectiveNeutrons);
+  accumulableManager->Register(fStackingTracks);
+  accumulableManager->Register(fStackingEdep);
+  accumulableManager->Register(fLayerEdeps);
+  accumulableManager->Register(fRegionSteps);
+  accumulableManager->Register(fCutoffScores);
+  accumulableManager->Register(fSpectra);
+  accumulableManager->Register(fLayerFlux);
+  accumulableManager->Register(fTritiumProduction);
+  accumulableManager->Register(fSurfaces.GetAccumulable());
+  accumulableManager->Register(fWindowMesh.GetAccumulable());
+
+  fStepsPerCutNeutron.assign(BlanketRegions::kNumberOfZones + 1, 0.);
+}
+
+RunAction::~RunAction()
+{
+  delete fMessenger;
+  if (outputFile.is_open()) {
+    outputFile.close();
+  }
+}
+
+void RunAction::BeginOfRunAction(const G4Run* run)
+{
+  G4RunManager::GetRunManager()->SetRandomNumberStore(false);
+
+  // Index the layer table by the (shared) volume registry IDs, so that
+  // every thread ends up with the same layout
+  fLayerEdeps.SetLabels(fVolumes->GetNames());
+  std::vector<G4String> stepLabels;
+  for (G4int zone = 0; zone <= BlanketRegions::kNumberOfZones; ++zone) {
+    for (const char* particle : {"neutron", "gamma", "e-/e+", "other"}) {
+      stepLabels.push_back(G4String(BlanketRegions::GetZoneName(zone)) + " " + particle);
+    }
+  }
+  fRegionSteps.SetLabels(stepLabels);
+  std::vector<G4String> cutoffLabels;
+  for (G4int zone = 0; zone <= BlanketRegions::kNumberOfZones; ++zone) {
+    for (const char* score : {"killed", "killed weight", "survivors", "added weight",
+                              "survivor steps"})
+    {
+      cutoffLabels.push_back(G4String(BlanketRegions::GetZoneName(zone)) + " " + score);
+    }
+  }
+  fCutoffScores.SetLabels(cutoffLabels);
+  EnergyBinning binning = (fSpectrumScale == EnergyBinning::kGroups)
+                            ? fSpectrumGroups
+                            : EnergyBinning(fSpectrumScale, fSpectrumBins, fSpectrumEMin,
+                                            fSpectrumEMax);
+  fSpectra.Configure({"before_W", "after_W", "before_EUROFER", "after_EUROFER"}, binning);
+  fSpectra.SetBatchSize(fSpectrumBatchSize);
+
+  std::vector<G4String> layerNames;
+  fInverseLayerVolumes.clear();
+  for (G4int layer = 0; layer < fVolumes->GetNumberOfLayers(); ++layer) {
+    layerNames.push_back(fVolumes->GetName(fVolumes->GetLayerID(layer)));
+    fInverseLayerVolumes.push_back(cm3 / fVolumes->GetLayerVolume(layer));
+  }
+  fLayerFlux.Configure(layerNames, binning);
+  fLayerFlux.SetBatchSize(fSpectrumBatchSize);
+  fSurfaces.Configure(*fVolumes, binning, fSpectrumBatchSize);
+  if (fCells && !fCells->GetWindowOutput().empty()) {
+    fWindowMesh.Configure(fCells->GetCellEdges(), fCells->GetCellArea(),
+                          fCells->GetWindowGroups(), fSpectrumBatchSize);
+  }
+  else {
+    fWindowMesh.Configure({}, 0., EnergyBinning(), fSpectrumBatchSize);
+  }
+
+  std::vector<G4String> tritiumLabels = {"analog", "track_length"};
+  tritiumLabels.insert(tritiumLabels.end(), layerNames.begin(), layerNames.end());
+  fTritiumProduction.SetLabels(tritiumLabels);
+  fTritiumXS.Build(*fVolumes);
+  if (CrossSectionBiasing* biasing = CrossSectionBiasing::GetInstance()) {
+    for (G4int channel = 0; channel < CrossSectionBiasing::kNumberOfChannels; ++channel) {
+      biasing->SetFactor(static_cast<CrossSectionBiasing::Channel>(channel),
+                         fCrossSectionFactors[channel]);
+    }
+  }
+  if (IsMaster() && !fTritiumXS.IsActive()) {
+    G4Exception("RunAction::BeginOfRunAction()", "B1Xs0002", JustWarning,
+                "No Li-6/Li-7 (n,t) data (/B1/tbr/crossSectionFile): the track-length TBR "
+                "estimator is off and only the analog TBR is reported.");
+  }
+
+  // Batch statistics: every thread uses the same quantity layout
+  std::vector<G4String> quantities = {"tbr_analog", "tbr_track_length"};
+  fEdepOffset = static_cast<G4int>(quantities.size());
+  for (const auto& name : layerNames) {
+    quantities.push_back("edep:" + name);
+  }
+  fCurrentOffset = static_cast<G4int>(quantities.size());
+  for (G4int id = 0; id < kNumberOfSpectra; ++id) {
+    quantities.push_back("current:" + fSpectra.GetLabel(id));
+  }
+  fBatchSums.assign(quantities.size(), 0.);
+  fBatchEvents = 0;
+  if (IsMaster()) {
+    ConvergenceMonitor::Instance()->BeginRun(quantities);
+  }
+
+  G4AccumulableManager::Instance()->Reset();
+  Logger::ResetCounters();
+
+  // Text outputs are written by the threads that process events
+  if (!IsMaster() || !G4Threading::IsMultithreadedApplication()) {
+    for (auto& sink : fSinks) {
+      sink.Open(run->GetRunID());
+    }
+  }
+
+  // Only the master writes the run summary; workers would otherwise
+  // truncate and interleave the same file
+  if (IsMaster()) {
+    if (!outputFile.is_open()) {
+      outputFile.open("neutron_spectrum.txt");
+      if (!outputFile.is_open()) {
+        G4cerr << "Error opening the output file!" << G4endl;
+        exit(1);
+      }
+    }
+    fSummary = Summary();
+    fSummary.runID = run->GetRunID();
+    fTimer.Start();
+  }
+}
+
+void RunAction::EndOfRunAction(const G4Run* run)
+{
+  for (auto& sink : fSinks) {
+    sink.Close();
+  }
+
+  // Workers have closed their parts before the master gets here
+  if (IsMaster()) {
+    for (const auto& sink : fSinks) {
+      OutputSink::Consolidate(sink.GetQuantity(), run->GetRunID());
+    }
+  }
+
+  G4int nofEvents = run->GetNumberOfEvent();
+  if (nofEvents == 0) return;
+
+  // Partial last batches are folded before the merge
+  fSpectra.Flush();
+  fLayerFlux.Flush();
+  fSurfaces.Flush();
+  fWindowMesh.Flush();
+  if (fBatchEvents > 0) {
+    ConvergenceMonitor::Instance()->AddBatch(fBatchSums, fBatchEvents);
+    std::fill(fBatchSums.begin(), fBatchSums.end(), 0.);
+    fBatchEvents = 0;
+  }
+
+  G4AccumulableManager* accumulableManager = G4AccumulableManager::Instance();
+  accumulableManager->Merge();
+
+  if (!IsMaster()) {
+    G4cout << "--------------------End of Local Run------------------------" << G4endl
+           << " The run consists of " << nofEvents << " events." << G4endl;
+    return;
+  }
+
+  fTimer.Stop();
+  G4double wallTime = fTimer.GetRealElapsed();
+
+  G4double edep = fEdep.GetValue();
+  G4double edep2 = fEdep2.GetValue();
+  G4double totalTritium = fTritiumTotal.GetValue();
+  G4double totalHelium = fHeliumTotal.GetValue();
+  G4double totalMultiplication = fMultiplicationTotal.GetValue();
+  G4double totalEffectiveNeutrons = fEffectiveNeutrons.GetValue();
+
+  G4double rms = edep2 - edep * edep / nofEvents;
+  rms = (rms > 0.) ? std::sqrt(rms) : 0.;
+
+  // Output summary
+  outputFile << "-------------------- End of Global Run ---------------------\n";
+
+  // Concepts can be switched between runs of the same process
+  const auto* detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  outputFile << "Run " << run->GetRunID() << ", geometry " << detector->GetStackFile() << "\n";
+
+  outputFile << "The run consists of " << nofEvents << " events.\n"
+             << "Total energy deposited: " << G4BestUnit(edep, "Energy") << "\n"
+             << "RMS: " << G4BestUnit(rms, "Energy") << "\n"
+             << "Total tritium nuclei produced: " << totalTritium << "\n"
+             << "Total helium nuclei produced: " << totalHelium << "\n"
+             << "Extra neutrons from (n,xn) multiplication: " << totalMultiplication << " ("
+             << totalMultiplication / nofEvents << " per source neutron)\n"
+             << "Effective neutrons (non-backscattered, weighted): "
+             << totalEffectiveNeutrons << " (" << totalEffectiveNeutrons / nofEvents
+             << " per source neutron)\n"
+             << "Worker threads: " << G4Threading::GetNumberOfRunningWorkerThreads()
+             << ", event loop wall time: " << wallTime << " s"
+             << " (" << (wallTime > 0. ? nofEvents / wallTime : 0.) << " events/s)\n";
+
+  // Heating not transported by the stacking action (kill or dropped defer)
+  G4double stackingTracks = fStackingTracks.GetValue();
+  if (stackingTracks > 0.) {
+    G4double stackingEdep = fStackingEdep.GetValue();
+    outputFile << "EM secondaries deposited on the spot: " << stackingTracks / nofEvents
+               << " per event, " << G4BestUnit(stackingEdep, "Energy") << " ("
+               << (edep > 0. ? 100. * stackingEdep / edep : 0.) << " % of the total); above "
+               << G4BestUnit(fVolumes->GetPhotoNeutronThreshold(), "Energy")
+               << " ((gamma,n) threshold) they are transported\n";
+  }
+
+  // Channels biased by -b crosssection; the weights keep every tally unbiased
+  if (detector->IsCrossSectionBiasingEnabled()) {
+    outputFile << "Cross-section biasing factors:";
+    for (G4int channel = 0; channel < CrossSectionBiasing::kNumberOfChannels; ++channel) {
+      outputFile << " " << CrossSectionBiasing::GetChannelName(channel) << " "
+                 << fCrossSectionFactors[channel];
+    }
+    outputFile << "\n";
+  }
+
+  // Output per-layer energy deposition
+  outputFile << "\n--- Energy deposition by layer ---\n";
+
+  for (std::size_t i = 0; i < fLayerEdeps.GetSize(); ++i) {
+    G4double edepVol = fLayerEdeps.GetSum(i);
+    if (edepVol <= 0.) continue;
+
+    const G4String& vol = fLayerEdeps.GetLabel(i);
+    outputFile << "Layer: " << vol
+               << ", Energy deposited: " << G4BestUnit(edepVol, "Energy")
+               << " (rel. error " << RelativeError(edepVol, fLayerEdeps.GetSum2(i), nofEvents)
+               << ")";
+
+    // Masses and volumes from the constructed geometry, by registry ID
+    G4double mass = fVolumes->GetMass(i);
+    G4double volume = fVolumes->GetNetVolume(i);
+    if (mass > 0.) {
+      outputFile << ", Mass: " << G4BestUnit(mass, "Mass")
+                 << ", Absorbed dose: " << G4BestUnit(edepVol / mass, "Dose")
+                 << ", Power density: " << edepVol / nofEvents / volume / (MeV / cm3)
+                 << " MeV/cm3 per source neutron";
+    }
+
+    outputFile << "\n";
+  }
+
+  // Tritium breeding ratio: analog count vs. track-length estimator.
+  // FOM = 1 / (R^2 T), both estimators share the same wall time T. The
+  // non-elastic approximation is another quantity than the analog count,
+  // so the track-length estimate needs evaluated (n,t) data.
+  G4bool trackLengthValid = fTritiumXS.IsActive();
+  G4double tbrAnalog = fTritiumProduction.GetSum(0) / nofEvents;
+  G4double errAnalog = RelativeError(fTritiumProduction.GetSum(0),
+                                     fTritiumProduction.GetSum2(0), nofEvents);
+  G4double tbrTrackLength = fTritiumProduction.GetSum(1) / nofEvents;
+  G4double errTrackLength = RelativeError(fTritiumProduction.GetSum(1),
+                                          fTritiumProduction.GetSum2(1), nofEvents);
+  auto figureOfMerit = [wallTime](G4double relError) {
+    return (relError > 0. && wallTime > 0.) ? 1. / (relError * relError * wallTime) : 0.;
+  };
+
+  outputFile << "\n--- Tritium breeding ratio (tritons per source neutron) ---\n"
+             << "Analog (tritons produced in any volume): " << tbrAnalog
+             << " (rel. error " << errAnalog << ", FOM " << figureOfMerit(errAnalog) << " /s)\n";
+  if (trackLengthValid) {
+    outputFile << "Track-length (" << fTritiumXS.GetDescription() << "): " << tbrTrackLength
+               << " (rel. error " << errTrackLength << ", FOM "
+               << figureOfMerit(errTrackLength) << " /s)\n";
+  }
+  else {
+    outputFile << "Track-length: not reported without evaluated (n,t) data"
+               << " (/B1/tbr/crossSectionFile)\n";
+  }
+  for (G4int layer = 0; trackLengthValid && layer < fVolumes->GetNumberOfLayers(); ++layer) {
+    if (!fTritiumXS.IsBreeder(layer)) continue;
+    G4double sum = fTritiumProduction.GetSum(2 + layer);
+    outputFile << "  Layer: " << fTritiumProduction.GetLabel(2 + layer)
+               << ", track-length TBR: " << sum / nofEvents << " (rel. error "
+               << RelativeError(sum, fTritiumProduction.GetSum2(2 + layer), nofEvents) << ")\n";
+  }
+  fSummary.nofEvents = nofEvents;
+  fSummary.wallTime = wallTime;
+  fSummary.tbrAnalog = tbrAnalog;
+  fSummary.tbrAnalogError = errAnalog;
+  fSummary.tbrTrackLengthValid = trackLengthValid;
+  fSummary.tbrTrackLength = tbrTrackLength;
+  fSummary.tbrTrackLengthError = errTrackLength;
+  fSummary.effectiveNeutrons = totalEffectiveNeutrons;
+  fSummary.helium = totalHelium;
+
+  if (trackLengthValid && errAnalog > 0. && errTrackLength > 0.) {
+    outputFile << "Track-length / analog FOM: "
+               << figureOfMerit(errTrackLength) / figureOfMerit(errAnalog) << "\n";
+  }
+
+  // Where the stepping time goes: steps per event by region and particle
+  G4double totalSteps = 0.;
+  for (std::size_t i = 0; i < fRegionSteps.GetSize(); ++i) {
+    totalSteps += fRegionSteps.GetSum(i);
+  }
+  outputFile << "\n--- Steps by region (per event, share of all steps) ---\n";
+  for (G4int zone = 0; zone <= BlanketRegions::kNumberOfZones; ++zone) {
+    G4double zoneSteps = 0.;
+    for (G4int c = 0; c < kNumberOfStepClasses; ++c) {
+      zoneSteps += fRegionSteps.GetSum(zone * kNumberOfStepClasses + c);
+    }
+    if (zoneSteps <= 0.) continue;
+    outputFile << "Region: " << BlanketRegions::GetZoneName(zone) << ", "
+               << zoneSteps / nofEvents << " steps (" << 100. * zoneSteps / totalSteps
+               << " %):";
+    for (G4int c = 0; c < kNumberOfStepClasses; ++c) {
+      std::size_t i = zone * kNumberOfStepClasses + c;
+      const G4String& label = fRegionSteps.GetLabel(i);
+      outputFile << " " << label.substr(label.find(' ') + 1) << " "
+                 << fRegionSteps.GetSum(i) / nofEvents;
+    }
+    outputFile << "\n";
+  }
+
+  // Neutrons cut per region and the weight they took with them. A killed
+  // neutron would have taken as many steps as a roulette survivor does;
+  // at the mean cost of a step, that gives the share of the time saved.
+  if (fCutoffs.IsActive()) {
+    outputFile << "\n--- Neutron cutoffs (per event) ---\n";
+    fCutoffs.Print(outputFile);
+    G4double savedSteps = 0.;
+    G4double lostWeight = 0.;
+    G4bool estimated = true;
+    for (G4int zone = 0; zone <= BlanketRegions::kNumberOfZones; ++zone) {
+      auto score = [this, zone](CutoffScore id) {
+        return fCutoffScores.GetSum(zone * kNumberOfCutoffScores + id);
+      };
+      G4double killed = score(kCutoffKilled);
+      G4double survivors = score(kCutoffSurvivors);
+      if (killed + survivors <= 0.) continue;
+      if (survivors > 0.) {
+        fStepsPerCutNeutron[zone] = score(kCutoffSurvivorSteps) / survivors;
+      }
+      G4double zoneLost = score(kCutoffKilledWeight) - score(kCutoffAddedWeight);
+      outputFile << "Region: " << BlanketRegions::GetZoneName(zone) << ", killed "
+                 << killed / nofEvents << ", survived " << survivors / nofEvents
+                 << ", weight lost " << zoneLost / nofEvents << " (killed "
+                 << score(kCutoffKilledWeight) / nofEvents << ", gained by survivors "
+                 << score(kCutoffAddedWeight) / nofEvents << "), steps per cut neutron ";
+      if (fStepsPerCutNeutron[zone] > 0. || survivors > 0.) {
+        outputFile << fStepsPerCutNeutron[zone] << "\n";
+      }
+      else {
+        outputFile << "unknown\n";
+        estimated = false;
+      }
+      savedSteps += killed * fStepsPerCutNeutron[zone];
+      lostWeight += zoneLost;
+    }
+    outputFile << "Weight lost: " << lostWeight / nofEvents << " per source neutron\n";
+    if (estimated && totalSteps + savedSteps > 0.) {
+      outputFile << "Estimated CPU time saved: " << 100. * savedSteps / (totalSteps + savedSteps)
+                 << " % (" << savedSteps / nofEvents << " neutron steps per event not taken)\n";
+    }
+    else {
+      outputFile << "Estimated CPU time saved: unknown until a roulette run has had survivors"
+                 << " in every region with cuts\n";
+    }
+  }
+
+  // Batch means over all threads; deposits in energy units, the rest per event
+  auto monitor = ConvergenceMonitor::Instance();
+  outputFile << "\n--- Batch statistics (" << monitor->GetNumberOfBatches() << " batches of "
+             << monitor->GetBatchSize() << " events) ---\n"
+             << "Run ended: " << monitor->GetStopReason() << "\n";
+  if (monitor->GetDropBatch() >= 0) {
+    outputFile << "Deferred EM secondaries deposited on the spot after batch "
+               << monitor->GetDropBatch() << "\n";
+  }
+  for (G4int i = 0; i < monitor->GetNumberOfQuantities(); ++i) {
+    if (i == 1 && !trackLengthValid) continue;  // tbr_track_length
+    G4bool isEdep = (i >= fEdepOffset && i < fCurrentOffset);
+    outputFile << monitor->GetQuantity(i) << ": ";
+    if (isEdep) {
+      outputFile << G4BestUnit(monitor->GetMean(i), "Energy");
+    } else {
+      outputFile << monitor->GetMean(i);
+    }
+    outputFile << " per event (rel. error " << monitor->GetRelativeError(i) << ", FOM "
+               << figureOfMerit(monitor->GetRelativeError(i)) << " /s)\n";
+  }
+
+  // Evenness of the mesh flux errors: the target of the weight windows
+  if (fWindowMesh.IsActive()) {
+    outputFile << "\n--- Weight-window mesh ("
+               << fWindowMesh.GetAccumulable().GetBinning().GetDescription() << ") ---\n";
+    fWindowMesh.PrintSummary(outputFile, nofEvents);
+  }
+
+  outputFile << "------------------------------------------------------------\n\n";
+
+  // Neutron spectra: one row per energy bin, crossings per source neutron
+  const EnergyBinning& binning = fSpectra.GetBinning();
+  std::ostringstream header;
+  header << "# Neutron crossings per source neutron, run " << run->GetRunID()
+         << ", " << nofEvents << " events\n"
+         << "# binning: " << binning.GetDescription() << ", errors over "
+         << fSpectra.GetNumberOfBatches() << " batches\n";
+  fSpectra.Write("neutron_spectra_run" + std::to_string(run->GetRunID()) + ".txt",
+                 header.str(), nofEvents);
+
+  // Volume-averaged flux per layer from the track-length estimator
+  std::ostringstream fluxHeader;
+  fluxHeader << "# Track-length neutron flux [cm-2 per source neutron], run "
+             << run->GetRunID() << ", " << nofEvents << " events\n"
+             << "# binning: " << binning.GetDescription() << ", errors over "
+             << fLayerFlux.GetNumberOfBatches() << " batches\n";
+  fLayerFlux.Write("layer_flux_run" + std::to_string(run->GetRunID()) + ".txt",
+                   fluxHeader.str(), nofEvents);
+
+  // Macro-declared boundary currents, if any
+  if (!fSurfaces.IsEmpty()) {
+    fSurfaces.Write("surface_currents_run" + std::to_string(run->GetRunID()) + ".txt",
+                    run->GetRunID(), nofEvents);
+  }
+
+  // Windows for the next run, from the flux of this one
+  if (fWindowMesh.IsActive()) {
+    fWindowMesh.WriteFlux("ww_flux_run" + std::to_string(run->GetRunID()) + ".txt",
+                          run->GetRunID(), nofEvents);
+    fWindowMesh.WriteWindows(fCells->GetWindowOutput(), fWindowMesh.MakeWindows(nofEvents),
+                             run->GetRunID(), nofEvents);
+    G4cout << "Weight windows written to " << fCells->GetWindowOutput() << G4endl;
+  }
+}
+
+void RunAction::AddEdep(G4double edep)
+{
+  fEdep += edep;
+  fEdep2 += edep * edep;
+}
+
+void RunAction::AddTritium(G4double count)
+{
+  fTritiumTotal += count;
+}
+
+void RunAction::AddHelium(G4double count)
+{
+  fHeliumTotal += count;
+}
+
+void RunAction::AddMultiplication(G4double count)
+{
+  fMultiplicationTotal += count;
+}
+
+void RunAction::EndOfEvent()
+{
+  fSpectra.EndOfEvent();
+  fLayerFlux.EndOfEvent();
+  fSurfaces.EndOfEvent();
+  fWindowMesh.EndOfEvent();
+
+  auto monitor = ConvergenceMonitor::Instance();
+  if (++fBatchEvents >= monitor->GetBatchSize()) {
+    monitor->AddBatch(fBatchSums, fBatchEvents);
+    std::fill(fBatchSums.begin(), fBatchSums.end(), 0.);
+    fBatchEvents = 0;
+  }
+
+  // Soft abort: the current event completes, every thread stops
+  if (monitor->StopRequested()) {
+    G4RunManager::GetRunManager()->AbortRun(true);
+  }
+}
+
+void RunAction::AddTritiumEstimates(G4double analogCount,
+                                    const std::vector<G4double>& trackLengthByLayer)
+{
+  G4double total = 0.;
+  for (std::size_t layer = 0; layer < trackLengthByLayer.size(); ++layer) {
+    if (trackLengthByLayer[layer] > 0.) {
+      fTritiumProduction.Fill(2 + layer, trackLengthByLayer[layer]);
+      total += trackLengthByLayer[layer];
+    }
+  }
+  fTritiumProduction.Fill(0, analogCount);
+  fTritiumProduction.Fill(1, total);
+  fBatchSums[0] += analogCount;
+  fBatchSums[1] += total;
+}
+
+void RunAction::AddRegionSteps(const std::vector<G4double>& counts)
+{
+  for (std::size_t i = 0; i < counts.size(); ++i) {
+    if (counts[i] > 0.) fRegionSteps.Fill(i, counts[i]);
+  }
+}
+
+void RunAction::AddCutoffScores(const std::vector<G4double>& scores)
+{
+  for (std::size_t i = 0; i < scores.size(); ++i) {
+    if (scores[i] > 0.) fCutoffScores.Fill(i, scores[i]);
+  }
+}
+
+void RunAction::AddEdepByVolume(G4int volumeID, G4double edep)
+{
+  fLayerEdeps.Fill(volumeID, edep);
+  G4int layer = fVolumes->GetLayerIndex(volumeID);
+  if (layer >= 0) fBatchSums[fEdepOffset + layer] += edep;
+}
+
+}  // namespace B1
@@ -0,0 +1,307 @@
+/// \file B1/src/RunMessenger.cc
+/// \brief Implementation of the B1::RunMessenger class
+
+#include "RunMessenger.hh"
+#include "RunAction.hh"
+#include "ConvergenceMonitor.hh"
+#include "CrossSectionBiasing.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <sstream>
+
+namespace B1
+{
+
+RunMessenger::RunMessenger(RunAction* runAction)
+  : fRunAction(runAction)
+{
+  fSpectrumDirectory = new G4UIdirectory("/B1/spectrum/");
+  fSpectrumDirectory->SetGuidance("Binning of the neutron spectra and layer fluxes.");
+
+  fBinningCmd = new G4UIcmdWithAString("/B1/spectrum/binning", this);
+  fBinningCmd->SetGuidance("Uniform linear or logarithmic energy bins.");
+  fBinningCmd->SetParameterName("scale", false);
+  fBinningCmd->SetCandidates("lin log");
+  fBinningCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fNBinsCmd = new G4UIcmdWithAnInteger("/B1/spectrum/nBins", this);
+  fNBinsCmd->SetGuidance("Number of energy bins.");
+  fNBinsCmd->SetParameterName("nBins", false);
+  fNBinsCmd->SetRange("nBins>0");
+  fNBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fEMinCmd = new G4UIcmdWithADoubleAndUnit("/B1/spectrum/eMin", this);
+  fEMinCmd->SetGuidance("Lower edge of the first bin (must be > 0 for log binning).");
+  fEMinCmd->SetParameterName("eMin", false);
+  fEMinCmd->SetUnitCategory("Energy");
+  fEMinCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fEMaxCmd = new G4UIcmdWithADoubleAndUnit("/B1/spectrum/eMax", this);
+  fEMaxCmd->SetGuidance("Upper edge of the last bin.");
+  fEMaxCmd->SetParameterName("eMax", false);
+  fEMaxCmd->SetUnitCategory("Energy");
+  fEMaxCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fBatchSizeCmd = new G4UIcmdWithAnInteger("/B1/spectrum/batchSize", this);
+  fBatchSizeCmd->SetGuidance("Events per batch for the statistical errors of the spectra.");
+  fBatchSizeCmd->SetGuidance("1 gives per-event variances.");
+  fBatchSizeCmd->SetParameterName("events", false);
+  fBatchSizeCmd->SetRange("events>0");
+  fBatchSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fGroupsCmd = new G4UIcmdWithAString("/B1/spectrum/groups", this);
+  fGroupsCmd->SetGuidance("Use a built-in group structure.");
+  fGroupsCmd->SetGuidance("Replaces the uniform binning until /B1/spectrum/binning is used.");
+  fGroupsCmd->SetParameterName("name", false);
+  fGroupsCmd->SetCandidates(EnergyBinning::GetStandardNames());
+  fGroupsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fGroupFileCmd = new G4UIcommand("/B1/spectrum/groupFile", this);
+  fGroupFileCmd->SetGuidance("Use a group structure (e.g. CCFE-709) read from");
+  fGroupFileCmd->SetGuidance("a file of group boundaries, in any order, '#' for comments.");
+  fGroupFileCmd->SetGuidance("Replaces the uniform binning until /B1/spectrum/binning is used.");
+  auto fileName = new G4UIparameter("fileName", 's', false);
+  fGroupFileCmd->SetParameter(fileName);
+  auto unit = new G4UIparameter("unit", 's', true);
+  unit->SetDefaultValue("MeV");
+  unit->SetParameterCandidates("meV eV keV MeV GeV");
+  fGroupFileCmd->SetParameter(unit);
+  fGroupFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSurfaceDirectory = new G4UIdirectory("/B1/surface/");
+  fSurfaceDirectory->SetGuidance("Boundary-crossing current tallies, applied at the next run.");
+
+  fSurfaceAddCmd = new G4UIcommand("/B1/surface/add", this);
+  fSurfaceAddCmd->SetGuidance("Tally the particles crossing from one volume into another.");
+  fSurfaceAddCmd->SetGuidance("Volume names as in the run summary; a trailing '*' matches a");
+  fSurfaceAddCmd->SetGuidance("prefix, '*' any volume. Written to surface_currents_run<N>.txt.");
+  auto tallyName = new G4UIparameter("name", 's', false);
+  fSurfaceAddCmd->SetParameter(tallyName);
+  auto from = new G4UIparameter("from", 's', false);
+  fSurfaceAddCmd->SetParameter(from);
+  auto to = new G4UIparameter("to", 's', false);
+  fSurfaceAddCmd->SetParameter(to);
+  auto particle = new G4UIparameter("particle", 's', true);
+  particle->SetDefaultValue("neutron");
+  fSurfaceAddCmd->SetParameter(particle);
+  auto direction = new G4UIparameter("direction", 's', true);
+  direction->SetDefaultValue("both");
+  direction->SetParameterCandidates("both forward backward");
+  fSurfaceAddCmd->SetParameter(direction);
+  fSurfaceAddCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSurfaceClearCmd = new G4UIcommand("/B1/surface/clear", this);
+  fSurfaceClearCmd->SetGuidance("Remove all surface tallies.");
+  fSurfaceClearCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fSurfaceCosBinsCmd = new G4UIcmdWithAnInteger("/B1/surface/nCosBins", this);
+  fSurfaceCosBinsCmd->SetGuidance("Bins in |cos| of the direction to the z axis, from 0 to 1.");
+  fSurfaceCosBinsCmd->SetParameterName("nBins", false);
+  fSurfaceCosBinsCmd->SetRange("nBins>0");
+  fSurfaceCosBinsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fTbrDirectory = new G4UIdirectory("/B1/tbr/");
+  fTbrDirectory->SetGuidance("Track-length tritium breeding ratio estimator.");
+
+  fTritiumXSCmd = new G4UIcommand("/B1/tbr/crossSectionFile", this);
+  fTritiumXSCmd->SetGuidance("Tabulated (n,t) cross section of Li-6 or Li-7, replacing the");
+  fTritiumXSCmd->SetGuidance("Geant4 Li non-elastic approximation. Columns: E [MeV], sigma [barn].");
+  auto massNumber = new G4UIparameter("A", 'i', false);
+  massNumber->SetParameterCandidates("6 7");
+  fTritiumXSCmd->SetParameter(massNumber);
+  auto xsFileName = new G4UIparameter("fileName", 's', false);
+  fTritiumXSCmd->SetParameter(xsFileName);
+  fTritiumXSCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fXSDirectory = new G4UIdirectory("/B1/xs/");
+  fXSDirectory->SetGuidance("Neutron cross-section biasing (exampleB1 -b crosssection).");
+
+  fXSFactorCmd = new G4UIcommand("/B1/xs/factor", this);
+  fXSFactorCmd->SetGuidance("Factor on the neutron inelastic cross section of a channel:");
+  fXSFactorCmd->SetGuidance("  tritium         Li-6(n,t), in the breeder slabs");
+  fXSFactorCmd->SetGuidance("  multiplication  Be-9(n,2n), in the multiplier slabs");
+  fXSFactorCmd->SetGuidance("1 switches the channel back to analog sampling.");
+  fXSFactorCmd->SetGuidance("No effect without -b crosssection.");
+  auto channel = new G4UIparameter("channel", 's', false);
+  channel->SetParameterCandidates("tritium multiplication");
+  fXSFactorCmd->SetParameter(channel);
+  auto factor = new G4UIparameter("factor", 'd', false);
+  factor->SetParameterRange("factor>0");
+  fXSFactorCmd->SetParameter(factor);
+  fXSFactorCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  fRunDirectory = new G4UIdirectory("/B1/run/");
+  fRunDirectory->SetGuidance("Batch statistics and convergence-driven run termination.");
+
+  fStopRelErrCmd = new G4UIcommand("/B1/run/stopRelErr", this);
+  fStopRelErrCmd->SetGuidance("Stop the run once the batch relative error of a quantity");
+  fStopRelErrCmd->SetGuidance("(tbr_analog, tbr_track_length, edep:<layer>, current:<interface>)");
+  fStopRelErrCmd->SetGuidance("falls below the target. 0 disables the rule.");
+  auto target = new G4UIparameter("relErr", 'd', false);
+  target->SetParameterRange("relErr>=0");
+  fStopRelErrCmd->SetParameter(target);
+  auto quantity = new G4UIparameter("quantity", 's', true);
+  quantity->SetDefaultValue("tbr_analog");
+  fStopRelErrCmd->SetParameter(quantity);
+  fStopRelErrCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fStopRelErrCmd->SetToBeBroadcasted(false);
+
+  fDropDeferredRelErrCmd = new G4UIcommand("/B1/run/dropDeferredRelErr", this);
+  fDropDeferredRelErrCmd->SetGuidance("With /B1/stack/mode defer, deposit the deferred EM");
+  fDropDeferredRelErrCmd->SetGuidance("secondaries on the spot instead of transporting them once");
+  fDropDeferredRelErrCmd->SetGuidance("the batch relative error of a quantity falls below the");
+  fDropDeferredRelErrCmd->SetGuidance("target. 0 disables the rule.");
+  auto dropTarget = new G4UIparameter("relErr", 'd', false);
+  dropTarget->SetParameterRange("relErr>=0");
+  fDropDeferredRelErrCmd->SetParameter(dropTarget);
+  auto dropQuantity = new G4UIparameter("quantity", 's', true);
+  dropQuantity->SetDefaultValue("tbr_analog");
+  fDropDeferredRelErrCmd->SetParameter(dropQuantity);
+  fDropDeferredRelErrCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fDropDeferredRelErrCmd->SetToBeBroadcasted(false);
+
+  fMaxWallTimeCmd = new G4UIcmdWithADoubleAndUnit("/B1/run/maxWallTime", this);
+  fMaxWallTimeCmd->SetGuidance("Stop the run after this wall time. 0 disables the rule.");
+  fMaxWallTimeCmd->SetParameterName("time", false);
+  fMaxWallTimeCmd->SetRange("time>=0");
+  fMaxWallTimeCmd->SetUnitCategory("Time");
+  fMaxWallTimeCmd->SetDefaultUnit("s");
+  fMaxWallTimeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fMaxWallTimeCmd->SetToBeBroadcasted(false);
+
+  fRunBatchSizeCmd = new G4UIcmdWithAnInteger("/B1/run/batchSize", this);
+  fRunBatchSizeCmd->SetGuidance("Events per batch, per thread, for the batch statistics.");
+  fRunBatchSizeCmd->SetParameterName("events", false);
+  fRunBatchSizeCmd->SetRange("events>0");
+  fRunBatchSizeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fRunBatchSizeCmd->SetToBeBroadcasted(false);
+
+  fMinBatchesCmd = new G4UIcmdWithAnInteger("/B1/run/minBatches", this);
+  fMinBatchesCmd->SetGuidance("Batches required before the relative error rule applies.");
+  fMinBatchesCmd->SetParameterName("batches", false);
+  fMinBatchesCmd->SetRange("batches>=2");
+  fMinBatchesCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fMinBatchesCmd->SetToBeBroadcasted(false);
+}
+
+RunMessenger::~RunMessenger()
+{
+  delete fMinBatchesCmd;
+  delete fRunBatchSizeCmd;
+  delete fMaxWallTimeCmd;
+  delete fDropDeferredRelErrCmd;
+  delete fStopRelErrCmd;
+  delete fRunDirectory;
+  delete fXSFactorCmd;
+  delete fXSDirectory;
+  delete fTritiumXSCmd;
+  delete fTbrDirectory;
+  delete fSurfaceCosBinsCmd;
+  delete fSurfaceClearCmd;
+  delete fSurfaceAddCmd;
+  delete fSurfaceDirectory;
+  delete fGroupFileCmd;
+  delete fGroupsCmd;
+  delete fEMaxCmd;
+  delete fEMinCmd;
+  delete fBatchSizeCmd;
+  delete fNBinsCmd;
+  delete fBinningCmd;
+  delete fSpectrumDirectory;
+}
+
+void RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fBinningCmd) {
+    fRunAction->SetSpectrumScale(newValue == "lin" ? EnergyBinning::kLinear
+                                                   : EnergyBinning::kLogarithmic);
+  }
+  else if (command == fNBinsCmd) {
+    fRunAction->SetSpectrumBins(fNBinsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fEMinCmd) {
+    fRunAction->SetSpectrumEMin(fEMinCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fEMaxCmd) {
+    fRunAction->SetSpectrumEMax(fEMaxCmd->GetNewDoubleValue(newValue));
+  }
+  else if (command == fBatchSizeCmd) {
+    fRunAction->SetSpectrumBatchSize(fBatchSizeCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fGroupsCmd) {
+    fRunAction->SetSpectrumGroups(EnergyBinning::FromName(newValue));
+  }
+  else if (command == fGroupFileCmd) {
+    std::istringstream is(newValue);
+    G4String fileName, unit;
+    is >> fileName >> unit;
+    fRunAction->SetSpectrumGroups(
+      EnergyBinning::FromFile(fileName, G4UIcommand::ValueOf(unit)));
+  }
+  else if (command == fSurfaceAddCmd) {
+    std::istringstream is(newValue);
+    SurfaceTallies::Declaration declaration;
+    G4String direction;
+    is >> declaration.name >> declaration.from >> declaration.to >> declaration.particle
+       >> direction;
+    declaration.direction = (direction == "forward")    ? SurfaceTallies::kForward
+                            : (direction == "backward") ? SurfaceTallies::kBackward
+                                                        : SurfaceTallies::kBoth;
+    fRunAction->AddSurfaceTally(declaration);
+  }
+  else if (command == fSurfaceClearCmd) {
+    fRunAction->ClearSurfaceTallies();
+  }
+  else if (command == fSurfaceCosBinsCmd) {
+    fRunAction->SetSurfaceCosineBins(fSurfaceCosBinsCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fTritiumXSCmd) {
+    std::istringstream is(newValue);
+    G4int massNumber;
+    G4String fileName;
+    is >> massNumber >> fileName;
+    fRunAction->LoadTritiumCrossSection(massNumber, fileName);
+  }
+  else if (command == fXSFactorCmd) {
+    std::istringstream is(newValue);
+    G4String channel;
+    G4double factor;
+    is >> channel >> factor;
+    fRunAction->SetCrossSectionFactor(channel == "tritium"
+                                        ? CrossSectionBiasing::kTritiumChannel
+                                        : CrossSectionBiasing::kMultiplicationChannel,
+                                      factor);
+  }
+  else if (command == fStopRelErrCmd) {
+    std::istringstream is(newValue);
+    G4double relativeError;
+    G4String quantity;
+    is >> relativeError >> quantity;
+    ConvergenceMonitor::Instance()->SetTarget(relativeError, quantity);
+  }
+  else if (command == fDropDeferredRelErrCmd) {
+    std::istringstream is(newValue);
+    G4double relativeError;
+    G4String quantity;
+    is >> relativeError >> quantity;
+    ConvergenceMonitor::Instance()->SetDropTarget(relativeError, quantity);
+  }
+  else if (command == fMaxWallTimeCmd) {
+    ConvergenceMonitor::Instance()->SetMaxWallTime(
+      fMaxWallTimeCmd->GetNewDoubleValue(newValue) / s);
+  }
+  else if (command == fRunBatchSizeCmd) {
+    ConvergenceMonitor::Instance()->SetBatchSize(fRunBatchSizeCmd->GetNewIntValue(newValue));
+  }
+  else if (command == fMinBatchesCmd) {
+    ConvergenceMonitor::Instance()->SetMinBatches(fMinBatchesCmd->GetNewIntValue(newValue));
+  }
+}
+
+}  // namespace B1
@@ -0,0 +1,239 @@
+/// \file B1/src/ScanDriver.cc
+/// \brief Implementation of the B1::ScanDriver and B1::ScanMessenger classes
+
+#include "ScanDriver.hh"
+#include "DetectorConstruction.hh"
+#include "RunAction.hh"
+
+#include "G4RunManager.hh"
+#include "G4StateManager.hh"
+#include "G4Timer.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIparameter.hh"
+
+#include <fstream>
+#include <sstream>
+
+namespace B1
+{
+
+ScanDriver::ScanDriver(DetectorConstruction* detector)
+  : fDetector(detector)
+{
+  fMessenger = new ScanMessenger(this);
+}
+
+ScanDriver::~ScanDriver()
+{
+  delete fMessenger;
+}
+
+std::vector<ScanDriver::Point> ScanDriver::ReadPoints(const G4String& fileName) const
+{
+  std::vector<Point> points;
+  std::ifstream in(fileName);
+  if (!in.is_open()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open scan file " << fileName << ".";
+    G4Exception("ScanDriver::ReadPoints()", "B1Scan0001", JustWarning, msg);
+    return points;
+  }
+
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream is(line.substr(0, line.find('#')));
+    Point point;
+    if (!(is >> point.label)) continue;
+
+    std::string rest;
+    std::getline(is, rest);
+    std::istringstream directives(rest);
+    std::string directive;
+    while (std::getline(directives, directive, ';')) {
+      if (directive.find_first_not_of(" \t") != std::string::npos) {
+        point.overrides.push_back(directive);
+      }
+    }
+    points.push_back(std::move(point));
+  }
+  return points;
+}
+
+void ScanDriver::RebuildGeometry(const std::vector<G4String>& overrides)
+{
+  fDetector->SetOverrides(overrides);
+  fDetector->ReleaseGeometry();
+
+  // Old volumes are deleted now, the new ones are built at the next run;
+  // only the couples of new materials get physics tables
+  G4RunManager::GetRunManager()->ReinitializeGeometry(true);
+}
+
+void ScanDriver::AddForcedCollisionVolume(const G4String& pattern)
+{
+  fDetector->AddForcedCollisionVolume(pattern);
+}
+
+void ScanDriver::SetStackFile(const G4String& stackFile)
+{
+  fDetector->SetStackFile(stackFile);
+  if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_Idle) {
+    RebuildGeometry({});
+  }
+}
+
+void ScanDriver::Run(const G4String& scanFile, G4int nofEvents)
+{
+  std::vector<Point> points = ReadPoints(scanFile);
+  if (points.empty()) return;
+
+  std::ofstream out(fOutputFile);
+  if (!out.is_open()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open scan output file " << fOutputFile << ".";
+    G4Exception("ScanDriver::Run()", "B1Scan0002", JustWarning, msg);
+    return;
+  }
+  out << "# Parameter scan of " << fDetector->GetStackFile() << " from " << scanFile
+      << ", " << nofEvents << " events per point\n"
+      << "# TBR per source neutron with relative errors; setup = point time minus"
+      << " event loop\n"
+      << "# label run events tbr_analog rel_err tbr_track_length rel_err"
+      << " effective_per_event helium_per_event setup_s event_loop_s overrides\n";
+
+  auto runManager = G4RunManager::GetRunManager();
+  const auto* runAction = static_cast<const RunAction*>(runManager->GetUserRunAction());
+
+  fDetector->SetCheckOverlaps(fCheckOverlaps);
+  for (const auto& point : points) {
+    G4cout << "=== Scan point " << point.label << " ===" << G4endl;
+
+    G4Timer timer;
+    timer.Start();
+    RebuildGeometry(point.overrides);
+    runManager->BeamOn(nofEvents);
+    timer.Stop();
+
+    const RunAction::Summary& summary = runAction->GetSummary();
+    G4int events = summary.nofEvents;
+    out << point.label << " " << summary.runID << " " << events << " " << summary.tbrAnalog
+        << " " << summary.tbrAnalogError << " ";
+    if (summary.tbrTrackLengthValid) {
+      out << summary.tbrTrackLength << " " << summary.tbrTrackLengthError << " ";
+    }
+    else {
+      out << "nan nan ";  // no evaluated (n,t) data
+    }
+    out
+        << (events > 0 ? summary.effectiveNeutrons / events : 0.) << " "
+        << (events > 0 ? summary.helium / events : 0.) << " "
+        << timer.GetRealElapsed() - summary.wallTime << " " << summary.wallTime;
+    for (const auto& directive : point.overrides) {
+      out << " " << directive << ";";
+    }
+    out << std::endl;
+  }
+
+  // Back to the nominal geometry, with the checks, for later runs
+  fDetector->SetCheckOverlaps(true);
+  RebuildGeometry({});
+}
+
+ScanMessenger::ScanMessenger(ScanDriver* driver)
+  : fDriver(driver)
+{
+  fGeometryDirectory = new G4UIdirectory("/B1/geometry/");
+  fGeometryDirectory->SetGuidance("Layer stack of the blanket.");
+
+  fStackFileCmd = new G4UIcmdWithAString("/B1/geometry/stackFile", this);
+  fStackFileCmd->SetGuidance("Layer stack file; the geometry is rebuilt at the next run.");
+  fStackFileCmd->SetParameterName("fileName", false);
+  fStackFileCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fStackFileCmd->SetToBeBroadcasted(false);
+
+  fConceptCmd = new G4UIcmdWithAString("/B1/geometry/concept", this);
+  fConceptCmd->SetGuidance("Blanket concept, read from <concept>.stack (wcll.stack, hcpb.stack);");
+  fConceptCmd->SetGuidance("the physics is kept, the geometry is rebuilt at the next run.");
+  fConceptCmd->SetParameterName("concept", false);
+  fConceptCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fConceptCmd->SetToBeBroadcasted(false);
+
+  fForceCollisionCmd = new G4UIcmdWithAString("/B1/geometry/forceCollision", this);
+  fForceCollisionCmd->SetGuidance("Force neutron collisions in a thin volume (exampleB1 -b");
+  fForceCollisionCmd->SetGuidance("forcedcollision): registry name, a trailing '*' matches a");
+  fForceCollisionCmd->SetGuidance("prefix. Repeat for more volumes; the default is the first wall.");
+  fForceCollisionCmd->SetParameterName("volume", false);
+  fForceCollisionCmd->AvailableForStates(G4State_PreInit);
+  fForceCollisionCmd->SetToBeBroadcasted(false);
+
+  fScanDirectory = new G4UIdirectory("/B1/scan/");
+  fScanDirectory->SetGuidance("In-process parameter scan over geometry variants.");
+
+  fRunCmd = new G4UIcommand("/B1/scan/run", this);
+  fRunCmd->SetGuidance("Run every point of a scan file: one line per point, a label");
+  fRunCmd->SetGuidance("followed by layer stack overrides separated by ';', e.g.");
+  fRunCmd->SetGuidance("  li6_60 enrich Li2TiO3 60");
+  fRunCmd->SetGuidance("Only the geometry is rebuilt between points.");
+  auto fileName = new G4UIparameter("fileName", 's', false);
+  fRunCmd->SetParameter(fileName);
+  auto events = new G4UIparameter("events", 'i', false);
+  events->SetParameterRange("events>0");
+  fRunCmd->SetParameter(events);
+  fRunCmd->AvailableForStates(G4State_Idle);
+  fRunCmd->SetToBeBroadcasted(false);
+
+  fOutputCmd = new G4UIcmdWithAString("/B1/scan/output", this);
+  fOutputCmd->SetGuidance("File of the scan results, one row per point.");
+  fOutputCmd->SetParameterName("fileName", false);
+  fOutputCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fOutputCmd->SetToBeBroadcasted(false);
+
+  fCheckOverlapsCmd = new G4UIcmdWithABool("/B1/scan/checkOverlaps", this);
+  fCheckOverlapsCmd->SetGuidance("Check the placements of every scan point (default false).");
+  fCheckOverlapsCmd->SetParameterName("check", true);
+  fCheckOverlapsCmd->SetDefaultValue(true);
+  fCheckOverlapsCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+  fCheckOverlapsCmd->SetToBeBroadcasted(false);
+}
+
+ScanMessenger::~ScanMessenger()
+{
+  delete fCheckOverlapsCmd;
+  delete fOutputCmd;
+  delete fRunCmd;
+  delete fScanDirectory;
+  delete fForceCollisionCmd;
+  delete fConceptCmd;
+  delete fStackFileCmd;
+  delete fGeometryDirectory;
+}
+
+void ScanMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fStackFileCmd) {
+    fDriver->SetStackFile(newValue);
+  }
+  else if (command == fConceptCmd) {
+    fDriver->SetStackFile(DetectorConstruction::GetConceptStackFile(newValue));
+  }
+  else if (command == fForceCollisionCmd) {
+    fDriver->AddForcedCollisionVolume(newValue);
+  }
+  else if (command == fRunCmd) {
+    std::istringstream is(newValue);
+    G4String fileName;
+    G4int events = 0;
+    is >> fileName >> events;
+    fDriver->Run(fileName, events);
+  }
+  else if (command == fOutputCmd) {
+    fDriver->SetOutputFile(newValue);
+  }
+  else if (command == fCheckOverlapsCmd) {
+    fDriver->SetCheckOverlaps(fCheckOverlapsCmd->GetNewBoolValue(newValue));
+  }
+}
+
+}  // namespace B1
@@ -0,0 +1,136 @@
+/// \file B1/src/SpectrumAccumulable.cc
+/// \brief Implementation of the B1::SpectrumAccumulable class
+
+#include "SpectrumAccumulable.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace B1
+{
+
+SpectrumAccumulable::SpectrumAccumulable(const G4String& name)
+  : G4VAccumulable(name)
+{}
+
+void SpectrumAccumulable::Merge(const G4VAccumulable& other)
+{
+  const auto& rhs = static_cast<const SpectrumAccumulable&>(other);
+  if (rhs.fSum.size() != fSum.size()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot merge " << GetName() << ": binning differs between threads.";
+    G4Exception("SpectrumAccumulable::Merge()", "B1Acc0002", FatalException, msg);
+    return;
+  }
+
+  for (std::size_t i = 0; i < fSum.size(); ++i) {
+    fSum[i] += rhs.fSum[i];
+    fSum2[i] += rhs.fSum2[i];
+    fSumN[i] += rhs.fSumN[i];
+  }
+  fNBatches += rhs.fNBatches;
+  fNEvents += rhs.fNEvents;
+  fNEvents2 += rhs.fNEvents2;
+}
+
+void SpectrumAccumulable::Reset()
+{
+  std::fill(fSum.begin(), fSum.end(), 0.);
+  std::fill(fSum2.begin(), fSum2.end(), 0.);
+  std::fill(fSumN.begin(), fSumN.end(), 0.);
+  std::fill(fBatch.begin(), fBatch.end(), 0.);
+  fTouched.clear();
+  fEventsInBatch = 0;
+  fNBatches = 0;
+  fNEvents = 0.;
+  fNEvents2 = 0.;
+}
+
+void SpectrumAccumulable::Print(G4PrintOptions) const
+{
+  G4cout << GetName() << ": " << fLabels.size() << " spectra, "
+         << fBinning.GetDescription() << G4endl;
+}
+
+void SpectrumAccumulable::Configure(const std::vector<G4String>& labels,
+                                    const EnergyBinning& binning)
+{
+  fLabels = labels;
+  fBinning = binning;
+  fSum.assign(labels.size() * binning.GetNumberOfBins(), 0.);
+  fSum2.assign(fSum.size(), 0.);
+  fSumN.assign(fSum.size(), 0.);
+  fBatch.assign(fSum.size(), 0.);
+  fTouched.clear();
+  fEventsInBatch = 0;
+  fNBatches = 0;
+  fNEvents = 0.;
+  fNEvents2 = 0.;
+}
+
+void SpectrumAccumulable::FoldBatch()
+{
+  for (auto index : fTouched) {
+    G4double value = fBatch[index];
+    fSum[index] += value;
+    fSum2[index] += value * value;
+    fSumN[index] += value * fEventsInBatch;
+    fBatch[index] = 0.;
+  }
+  fTouched.clear();
+  fNEvents += fEventsInBatch;
+  fNEvents2 += static_cast<G4double>(fEventsInBatch) * fEventsInBatch;
+  fEventsInBatch = 0;
+  ++fNBatches;
+}
+
+G4double SpectrumAccumulable::GetRelativeError(G4int spectrum, G4int bin) const
+{
+  // Ratio estimator over batches b of n_b events and sum S_b:
+  // var(mean) = B / (B - 1) * sum_b (S_b - mean n_b)^2 / N^2
+  G4int index = spectrum * fBinning.GetNumberOfBins() + bin;
+  G4double sum = fSum[index];
+  if (sum == 0. || fNBatches < 2) return 0.;
+  G4double mean = sum / fNEvents;
+  G4double deviations = fSum2[index] - 2. * mean * fSumN[index] + mean * mean * fNEvents2;
+  G4double variance = fNBatches / (fNBatches - 1.) * deviations / (fNEvents * fNEvents);
+  return (variance > 0.) ? std::sqrt(variance) / std::abs(mean) : 0.;
+}
+
+void SpectrumAccumulable::Write(const G4String& fileName, const G4String& header,
+                                G4int nofEvents) const
+{
+  std::ofstream out(fileName, std::ios::trunc);
+  if (!out.is_open()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open " << fileName << " for writing.";
+    G4Exception("SpectrumAccumulable::Write()", "B1Out0002", JustWarning, msg);
+    return;
+  }
+
+  out << header;
+  out << "# E_low[MeV] E_high[MeV]";
+  for (const auto& label : fLabels) {
+    out << " " << label << " " << label << "_rel_err " << label << "_per_lethargy";
+  }
+  out << "\n";
+
+  const auto& edges = fBinning.GetEdges();
+  for (G4int bin = 0; bin < fBinning.GetNumberOfBins(); ++bin) {
+    G4double lethargy = fBinning.GetLethargyWidth(bin);
+    out << edges[bin] / MeV << " " << edges[bin + 1] / MeV;
+    for (G4int spectrum = 0; spectrum < GetNumberOfSpectra(); ++spectrum) {
+      G4double sum = GetSum(spectrum, bin);
+      G4double mean = (nofEvents > 0) ? sum / nofEvents : 0.;
+      out << " " << mean << " " << GetRelativeError(spectrum, bin) << " "
+          << (lethargy > 0. ? mean / lethargy : 0.);
+    }
+    out << "\n";
+  }
+}
+
+}  // namespace B1
@@ -0,0 +1,138 @@
+/// \file B1/src/StackingAction.cc
+/// \brief Implementation of the B1::StackingAction and B1::StackingMessenger classes
+
+#include "StackingAction.hh"
+#include "ConvergenceMonitor.hh"
+#include "EventAction.hh"
+#include "RunAction.hh"
+#include "VolumeRegistry.hh"
+
+#include "G4Electron.hh"
+#include "G4Gamma.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4Positron.hh"
+#include "G4StackManager.hh"
+#include "G4Track.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIdirectory.hh"
+#include "G4VPhysicalVolume.hh"
+
+namespace B1
+{
+
+StackingAction::StackingAction(EventAction* eventAction, RunAction* runAction,
+                               const VolumeRegistry* volumes)
+  : fEventAction(eventAction),
+    fRunAction(runAction),
+    fVolumes(volumes),
+    fGamma(G4Gamma::Definition()),
+    fElectron(G4Electron::Definition()),
+    fPositron(G4Positron::Definition())
+{
+  fMessenger = new StackingMessenger(this);
+}
+
+StackingAction::~StackingAction()
+{
+  delete fMessenger;
+}
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  if (fMode == kFull || track->GetParentID() == 0) return fUrgent;
+
+  const G4ParticleDefinition* particle = track->GetDefinition();
+  if (particle != fGamma && particle != fElectron && particle != fPositron) return fUrgent;
+
+  // Above it they can still knock out neutrons
+  if (track->GetKineticEnergy() >= fVolumes->GetPhotoNeutronThreshold()) return fUrgent;
+
+  if (fMode == kKill) {
+    fRunAction->AddStackingDeposit(1, Deposit(track));
+    return fKill;
+  }
+
+  // Deferred tracks come back here when the waiting stack is released
+  if (fStage > 0) return fUrgent;
+
+  G4double energy = track->GetKineticEnergy();
+  if (particle == fPositron) energy += 2. * electron_mass_c2;
+  energy *= track->GetWeight();
+  const G4VPhysicalVolume* volume = track->GetVolume();
+  if (volume) fDeferredEnergy[volume->GetCopyNo()] += energy;
+  ++fDeferredTracks;
+  return fWaiting;
+}
+
+void StackingAction::NewStage()
+{
+  // The neutron cascade is over; only deferred EM secondaries are left
+  if (fStage++ > 0) return;
+
+  if (ConvergenceMonitor::Instance()->DropRequested()) {
+    G4double total = 0.;
+    for (std::size_t id = 0; id < fDeferredEnergy.size(); ++id) {
+      if (fDeferredEnergy[id] <= 0.) continue;
+      fEventAction->AddEdep(fDeferredEnergy[id]);
+      fEventAction->AddEdepByVolume(id, fDeferredEnergy[id]);
+      total += fDeferredEnergy[id];
+    }
+    fRunAction->AddStackingDeposit(fDeferredTracks, total);
+    stackManager->clear();
+  }
+  else {
+    stackManager->ReClassify();
+  }
+}
+
+void StackingAction::PrepareNewEvent()
+{
+  fStage = 0;
+  fDeferredEnergy.assign(fVolumes->GetSize(), 0.);
+  fDeferredTracks = 0;
+}
+
+G4double StackingAction::Deposit(const G4Track* track)
+{
+  G4double energy = track->GetKineticEnergy();
+  if (track->GetDefinition() == fPositron) energy += 2. * electron_mass_c2;
+  energy *= track->GetWeight();
+  fEventAction->AddEdep(energy);
+  const G4VPhysicalVolume* volume = track->GetVolume();
+  if (volume) fEventAction->AddEdepByVolume(volume->GetCopyNo(), energy);
+  return energy;
+}
+
+StackingMessenger::StackingMessenger(StackingAction* stackingAction)
+  : fStackingAction(stackingAction)
+{
+  fDirectory = new G4UIdirectory("/B1/stack/");
+  fDirectory->SetGuidance("Transport of the EM secondaries (gammas, e-, e+).");
+
+  fModeCmd = new G4UIcmdWithAString("/B1/stack/mode", this);
+  fModeCmd->SetGuidance("full: transport everything; kill: deposit EM secondaries where they");
+  fModeCmd->SetGuidance("are born; defer: transport them after the neutron cascade of the");
+  fModeCmd->SetGuidance("event, or deposit them once /B1/run/dropDeferredRelErr is met.");
+  fModeCmd->SetGuidance("Photons and electrons above the lowest (gamma,n) threshold of the");
+  fModeCmd->SetGuidance("materials are always transported.");
+  fModeCmd->SetParameterName("mode", false);
+  fModeCmd->SetCandidates("full kill defer");
+  fModeCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+}
+
+StackingMessenger::~StackingMessenger()
+{
+  delete fModeCmd;
+  delete fDirectory;
+}
+
+void StackingMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fModeCmd) {
+    fStackingAction->SetMode(newValue == "kill"    ? StackingAction::kKill
+                             : newValue == "defer" ? StackingAction::kDefer
+                                                   : StackingAction::kFull);
+  }
+}
+
+}  // namespace B1
@@ -0,0 +1,297 @@
+/// \file B1/src/SteppingAction.cc
+/// \brief Implementation of the B1::SteppingAction class
+
+#include "SteppingAction.hh"
+#include "CrossSectionBiasing.hh"
+#include "EventAction.hh"
+#include "NeutronCutoffs.hh"
+#include "NeutronTrackInformation.hh"
+#include "RunAction.hh"
+#include "VolumeRegistry.hh"
+#include "BlanketRegions.hh"
+#include "TritiumCrossSections.hh"
+#include "SurfaceTallies.hh"
+#include "WeightWindowMesh.hh"
+#include "Logger.hh"
+
+#include "G4Step.hh"
+#include "G4SteppingManager.hh"
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Neutron.hh"
+#include "G4Triton.hh"
+#include "G4Alpha.hh"
+#include "G4Electron.hh"
+#include "G4Gamma.hh"
+#include "G4Positron.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4LogicalVolume.hh"
+#include "G4TouchableHandle.hh"
+#include "G4VProcess.hh"
+#include "G4ios.hh"
+#include "Randomize.hh"
+
+namespace
+{
+// Splitting and roulette also add neutrons to a step; only the products
+// of a nuclear reaction count as multiplication
+G4bool IsReactionProduct(const G4Track* track)
+{
+  const G4VProcess* creator = track->GetCreatorProcess();
+  return creator && creator->GetProcessType() == fHadronic;
+}
+}  // namespace
+
+namespace B1
+{
+
+SteppingAction::SteppingAction(EventAction* eventAction, RunAction* runAction,
+                               const VolumeRegistry* volumes)
+  : G4UserSteppingAction(),
+    fEventAction(eventAction),
+    fRunAction(runAction),
+    fVolumes(volumes),
+    fTritonSink(runAction->GetSink(RunAction::kTritonDepth)),
+    fAlphaSink(runAction->GetSink(RunAction::kAlphaDepth)),
+    fMultiplicationSink(runAction->GetSink(RunAction::kMultiplicationDepth)),
+    fTritiumXS(runAction->GetTritiumCrossSections()),
+    fSurfaces(runAction->GetSurfaceTallies()),
+    fWindowMesh(runAction->GetWindowMesh()),
+    fCutoffs(runAction->GetNeutronCutoffs()),
+    fNeutron(G4Neutron::Definition()),
+    fTriton(G4Triton::Definition()),
+    fAlpha(G4Alpha::Definition()),
+    fGamma(G4Gamma::Definition()),
+    fElectron(G4Electron::Definition()),
+    fPositron(G4Positron::Definition())
+{}
+
+SteppingAction::~SteppingAction() = default;
+
+void SteppingAction::UserSteppingAction(const G4Step* step)
+{
+  G4Track* track = step->GetTrack();
+  G4bool isNeutron = (track->GetDefinition() == fNeutron);
+
+  auto preVolume = step->GetPreStepPoint()->GetTouchableHandle()->GetVolume();
+  auto postVolume = step->GetPostStepPoint()->GetTouchableHandle()->GetVolume();
+
+  if (!preVolume || !postVolume) return;
+
+  // Registry IDs are the copy numbers of the placements
+  G4int preID = preVolume->GetCopyNo();
+  G4int postID = postVolume->GetCopyNo();
+  const G4String& preName = preVolume->GetName();
+
+  // --- Step count by region and particle class
+  const G4ParticleDefinition* particle = track->GetDefinition();
+  G4int stepClass = isNeutron                                          ? RunAction::kNeutronSteps
+                    : particle == fGamma                               ? RunAction::kGammaSteps
+                    : (particle == fElectron || particle == fPositron) ? RunAction::kElectronSteps
+                                                                       : RunAction::kOtherSteps;
+  G4int zone = BlanketRegions::GetZone(fVolumes->GetKind(preID));
+  fEventAction->CountStep(zone * RunAction::kNumberOfStepClasses + stepClass);
+
+  G4double energy = track->GetKineticEnergy();
+  G4double interfaceZ = fVolumes->GetDepthOrigin();  // from the layer stack
+
+  // Weight carried along this step, before any splitting or roulette at
+  // its end; the tallies are weighted with it
+  const G4StepPoint* prePoint = step->GetPreStepPoint();
+  G4double weight = prePoint->GetWeight();
+
+  // Biased cross sections change the weight continuously along the
+  // flight: crossings see its value at the end, track lengths its integral
+  G4double stepLength = step->GetStepLength();
+  G4double crossingWeight = weight;
+  G4double trackLength = stepLength * weight;
+  if (isNeutron) {
+    if (const CrossSectionBiasing* biasing = CrossSectionBiasing::GetInstance()) {
+      crossingWeight = weight * biasing->GetSurvivalFactor(track, stepLength);
+      trackLength = weight * biasing->GetWeightedLength(track, stepLength);
+    }
+  }
+
+  // Forced collisions split a neutron entering a thin volume into an
+  // uncollided copy, whose weight drops on its way out, and a collided one,
+  // whose weight is set at the collision: both are seen in the post-step
+  // weight, and their flights are not track-length samples
+  const G4StepPoint* postPoint = step->GetPostStepPoint();
+  G4bool forced = isNeutron && fVolumes->IsForcedCollision(preID);
+  if (forced) {
+    crossingWeight = postPoint->GetWeight();
+  }
+
+  // --- Record energy deposition in the volume where it actually occurred (post-step)
+  G4double edep = step->GetTotalEnergyDeposit() * (forced ? postPoint->GetWeight() : weight);
+  if (edep > 0.) {
+    fEventAction->AddEdep(edep);
+    fEventAction->AddEdepByVolume(postID, edep);
+  }
+
+  // --- Declared surface currents, on boundary crossings only
+  if (postPoint->GetStepStatus() == fGeomBoundary && !fSurfaces.IsEmpty()) {
+    for (auto tally : fSurfaces.Find(preID, postID)) {
+      fSurfaces.Score(tally, track->GetDefinition(), energy,
+                      postPoint->GetMomentumDirection().z(), crossingWeight);
+    }
+  }
+
+  // --- Neutron tracking ---
+  if (isNeutron) {
+    G4double preEnergy = prePoint->GetKineticEnergy();
+
+    // Mesh flux for the next weight-window file
+    if (fWindowMesh.IsActive() && !forced) {
+      fWindowMesh.Score(prePoint->GetPosition().z(), postPoint->GetPosition().z(), preEnergy,
+                        trackLength);
+    }
+
+    // Track-length flux estimator in the layer the step was taken in
+    G4int layer = forced ? -1 : fVolumes->GetLayerIndex(preID);
+    if (layer >= 0) {
+      fRunAction->FillLayerFlux(layer, preEnergy, trackLength);
+
+      // Track-length TBR estimator: expected (n,t) reactions along the step
+      if (fTritiumXS.IsActive()) {
+        G4double sigmaT = fTritiumXS.GetMacroscopic(layer, preEnergy);
+        if (sigmaT > 0.) {
+          fEventAction->AddTrackLengthTritium(layer, trackLength * sigmaT);
+        }
+      }
+    }
+
+    // Track energy before and after materials
+    unsigned transition = fVolumes->GetTransition(preID, postID);
+    if (transition != VolumeRegistry::kNone) {
+      // Envelope → first wall
+      if (transition & VolumeRegistry::kBeforeW) {
+        fEventAction->AddEnergyBeforeW(energy, crossingWeight);
+        fEventAction->IncrementNeutronInCount();
+      }
+
+      // First wall → Envelope
+      if (transition & VolumeRegistry::kBackscatter) {
+        fEventAction->MarkBackscattered();
+      }
+
+      // First wall → multiplier or breeder
+      if (transition & VolumeRegistry::kAfterW) {
+        fEventAction->AddEnergyAfterW(energy, crossingWeight);
+      }
+      // First slab behind the wall; backscattered neutrons that come back
+      // are not counted again
+      if (transition & VolumeRegistry::kEffective) {
+        auto info = NeutronTrackInformation::Get(track);
+        if (!info->effectiveCounted) {
+          info->effectiveCounted = true;
+          fEventAction->AddEffectiveNeutron(crossingWeight);
+        }
+      }
+
+      // Breeder → back plate
+      if (transition & VolumeRegistry::kBeforeEUROFER) {
+        fEventAction->AddEnergyBeforeEUROFER(energy, crossingWeight);
+      }
+
+      // Back plate → Envelope
+      if (transition & VolumeRegistry::kAfterEUROFER) {
+        fEventAction->AddEnergyAfterEUROFER(energy, crossingWeight);
+      }
+    }
+  }
+
+  // --- Secondaries: classify by definition pointer in a single pass
+  const auto* secondaries = step->GetSecondaryInCurrentStep();
+  int neutronCount = 0;
+  for (const auto* secondary : *secondaries) {
+    const G4ParticleDefinition* definition = secondary->GetDefinition();
+
+    // Tritium (triton) production in any volume
+    if (definition == fTriton) {
+      G4double z_relative = secondary->GetPosition().z() - interfaceZ;
+
+      B1_LOG(kTriton, kSecondary)
+        << "[TRITON] Tritium produced in " << preName << " at "
+        << secondary->GetPosition() / cm << " cm, E = "
+        << secondary->GetKineticEnergy() / MeV << " MeV" << G4endl;
+
+      fTritonSink.Stream() << z_relative / cm << " " << secondary->GetWeight() << "\n";
+
+      fEventAction->AddTritium(secondary->GetWeight());
+    }
+    // Helium (alpha) production in any volume
+    else if (definition == fAlpha) {
+      G4double z_relative = secondary->GetPosition().z() - interfaceZ;
+
+      B1_LOG(kHelium, kSecondary)
+        << "[HELIUM] Alpha produced in " << preName << " at "
+        << secondary->GetPosition() / cm << " cm, E = "
+        << secondary->GetKineticEnergy() / MeV << " MeV" << G4endl;
+
+      fAlphaSink.Stream() << z_relative / cm << " " << secondary->GetWeight() << "\n";
+
+      fEventAction->AddHelium(secondary->GetWeight());
+    }
+    else if (definition == fNeutron && IsReactionProduct(secondary)) {
+      ++neutronCount;
+    }
+  }
+
+  // --- Neutron multiplication (n,kn) with k > 1; rare, so a second pass
+  if (isNeutron && neutronCount > 1) {
+    for (const auto* sec : *secondaries) {
+      if (sec->GetDefinition() == fNeutron && IsReactionProduct(sec)) {
+        const G4String& volName = preName;
+        G4double z_relative = sec->GetPosition().z() - interfaceZ;
+
+        B1_LOG(kMultiplication, kSecondary)
+          << "[MULT] Neutron multiplication (" << neutronCount
+          << " neutrons) in " << volName << " at "
+          << sec->GetPosition() / cm << " cm" << G4endl;
+
+        fMultiplicationSink.Stream() << volName << " " << z_relative / cm << " "
+                                     << sec->GetWeight() << "\n";
+
+        // One of the k neutrons stands for the incoming one
+        fEventAction->AddMultiplication(sec->GetWeight() * (neutronCount - 1) / neutronCount);
+      }
+    }
+  }
+
+  // --- Energy and time cutoffs: a neutron is played on each step that
+  // takes it into the cut domain; a new track is checked on its first step
+  if (isNeutron && fCutoffs.IsActive()) {
+    // Survivors carry the step counter of the zone where they were played
+    auto info = static_cast<const NeutronTrackInformation*>(track->GetUserInformation());
+    if (info && info->cutoffStepIndex >= 0) {
+      fEventAction->CountCutoffSurvivorStep(info->cutoffStepIndex);
+    }
+
+    G4bool wasCut = track->GetCurrentStepNumber() > 1
+                    && fCutoffs.IsCut(zone, prePoint->GetKineticEnergy(), prePoint->GetGlobalTime());
+    G4int postZone = BlanketRegions::GetZone(fVolumes->GetKind(postID));
+    if (!wasCut && track->GetTrackStatus() == fAlive
+        && fCutoffs.IsCut(postZone, postPoint->GetKineticEnergy(), postPoint->GetGlobalTime()))
+    {
+      G4double survival = fCutoffs.GetSurvivalProbability();
+      G4double trackWeight = track->GetWeight();
+      if (survival > 0. && G4UniformRand() < survival) {
+        // The next step starts from this post-step point, the tallies
+        // take its weight
+        G4double survivorWeight = trackWeight / survival;
+        track->SetWeight(survivorWeight);
+        fpSteppingManager->GetStep()->GetPostStepPoint()->SetWeight(survivorWeight);
+        NeutronTrackInformation::Get(track)->cutoffStepIndex =
+          fEventAction->AddCutoffSurvivor(postZone, survivorWeight - trackWeight);
+      }
+      else {
+        track->SetTrackStatus(fStopAndKill);
+        fEventAction->AddCutoffKill(postZone, trackWeight);
+      }
+    }
+  }
+}
+
+}  // namespace B1
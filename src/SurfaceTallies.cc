@@ -0,0 +1,120 @@
+/// \file B1/src/SurfaceTallies.cc
+/// \brief Implementation of the B1::SurfaceTallies class
+
+#include "SurfaceTallies.hh"
+#include "VolumeRegistry.hh"
+
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+
+#include <algorithm>
+#include <sstream>
+
+namespace
+{
+// Registry name against a declared volume; a trailing '*' matches a prefix
+G4bool Matches(const G4String& pattern, const G4String& name)
+{
+  if (!pattern.empty() && pattern.back() == '*') {
+    return name.compare(0, pattern.size() - 1, pattern, 0, pattern.size() - 1) == 0;
+  }
+  return name == pattern;
+}
+}  // namespace
+
+namespace B1
+{
+
+SurfaceTallies::SurfaceTallies() = default;
+
+void SurfaceTallies::Add(const Declaration& declaration)
+{
+  auto sameName = [&declaration](const Declaration& other) {
+    return other.name == declaration.name;
+  };
+  if (std::any_of(fDeclarations.begin(), fDeclarations.end(), sameName)) {
+    G4ExceptionDescription msg;
+    msg << "Surface tally " << declaration.name << " is already declared; ignored.";
+    G4Exception("SurfaceTallies::Add()", "B1Surf0001", JustWarning, msg);
+    return;
+  }
+  if (declaration.particle != "all"
+      && !G4ParticleTable::GetParticleTable()->FindParticle(declaration.particle))
+  {
+    G4ExceptionDescription msg;
+    msg << "Unknown particle " << declaration.particle << " for surface tally "
+        << declaration.name << "; ignored.";
+    G4Exception("SurfaceTallies::Add()", "B1Surf0001", JustWarning, msg);
+    return;
+  }
+  fDeclarations.push_back(declaration);
+}
+
+void SurfaceTallies::Configure(const VolumeRegistry& volumes, const EnergyBinning& binning,
+                               G4int batchSize)
+{
+  fNVolumes = volumes.GetSize();
+  fTable.assign(fNVolumes * fNVolumes, {});
+  fTallies.clear();
+
+  std::vector<G4String> labels;
+  for (const auto& declaration : fDeclarations) {
+    G4int tally = static_cast<G4int>(fTallies.size());
+    G4int pairs = 0;
+    for (G4int from = 0; from < fNVolumes; ++from) {
+      if (!Matches(declaration.from, volumes.GetName(from))) continue;
+      for (G4int to = 0; to < fNVolumes; ++to) {
+        if (to == from || !Matches(declaration.to, volumes.GetName(to))) continue;
+        fTable[from * fNVolumes + to].push_back(tally);
+        ++pairs;
+      }
+    }
+    if (pairs == 0) {
+      G4ExceptionDescription msg;
+      msg << "Surface tally " << declaration.name << " (" << declaration.from << " -> "
+          << declaration.to << ") matches no pair of volumes.";
+      G4Exception("SurfaceTallies::Configure()", "B1Surf0002", JustWarning, msg);
+    }
+
+    Tally t;
+    if (declaration.particle != "all") {
+      t.particle = G4ParticleTable::GetParticleTable()->FindParticle(declaration.particle);
+    }
+    t.direction = declaration.direction;
+    fTallies.push_back(t);
+
+    for (G4int bin = 0; bin < fCosineBins; ++bin) {
+      std::ostringstream label;
+      label << declaration.name;
+      if (fCosineBins > 1) label << "_mu" << bin;
+      labels.push_back(label.str());
+    }
+  }
+
+  fCurrents.Configure(labels, binning);
+  fCurrents.SetBatchSize(batchSize);
+}
+
+void SurfaceTallies::Write(const G4String& fileName, G4int runID, G4int nofEvents) const
+{
+  std::ostringstream header;
+  header << "# Surface currents [crossings per source neutron], run " << runID << ", "
+         << nofEvents << " events\n"
+         << "# binning: " << fCurrents.GetBinning().GetDescription() << ", errors over "
+         << fCurrents.GetNumberOfBatches() << " batches\n";
+  for (const auto& declaration : fDeclarations) {
+    header << "# " << declaration.name << ": " << declaration.from << " -> " << declaration.to
+           << ", " << declaration.particle << ", "
+           << (declaration.direction == kForward    ? "forward"
+               : declaration.direction == kBackward ? "backward"
+                                                    : "both")
+           << "\n";
+  }
+  if (fCosineBins > 1) {
+    header << "# _mu<i>: |cos| to the z axis in [i/" << fCosineBins << ", (i+1)/"
+           << fCosineBins << ")\n";
+  }
+  fCurrents.Write(fileName, header.str(), nofEvents);
+}
+
+}  // namespace B1
@@ -0,0 +1,111 @@
+/// \file B1/src/TritiumCrossSections.cc
+/// \brief Implementation of the B1::TritiumCrossSections class
+
+#include "TritiumCrossSections.hh"
+#include "VolumeRegistry.hh"
+
+#include "G4Element.hh"
+#include "G4Isotope.hh"
+#include "G4Material.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+// Cache grid: 100 points per decade from 1e-5 eV to 20 MeV
+const G4double gridEMin = 1.e-5 * eV;
+const G4double gridEMax = 20. * MeV;
+const G4int gridPointsPerDecade = 100;
+}  // namespace
+
+namespace B1
+{
+
+void TritiumCrossSections::LoadIsotopeData(G4int massNumber, const G4String& fileName)
+{
+  std::ifstream in(fileName);
+  if (!in.is_open() || (massNumber != 6 && massNumber != 7)) {
+    G4ExceptionDescription msg;
+    msg << "Cannot load Li-" << massNumber << " (n,t) data from " << fileName << ".";
+    G4Exception("TritiumCrossSections::LoadIsotopeData()", "B1Xs0001", FatalException, msg);
+    return;
+  }
+
+  std::vector<std::pair<G4double, G4double>> points;
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream is(line.substr(0, line.find('#')));
+    G4double energy, sigma;
+    if (is >> energy >> sigma) {
+      points.emplace_back(energy * MeV, sigma * barn);
+    }
+  }
+  std::sort(points.begin(), points.end());
+
+  IsotopeData& data = (massNumber == 6) ? fLi6 : fLi7;
+  data.energies.clear();
+  data.sigmas.clear();
+  for (const auto& [energy, sigma] : points) {
+    data.energies.push_back(energy);
+    data.sigmas.push_back(sigma);
+  }
+}
+
+G4double TritiumCrossSections::GetIsotopeSigma(const IsotopeData& data, G4double energy) const
+{
+  // Linear interpolation, zero outside the tabulated range
+  const auto& e = data.energies;
+  if (e.empty() || energy < e.front() || energy > e.back()) return 0.;
+  auto it = std::upper_bound(e.begin(), e.end(), energy);
+  if (it == e.end()) return data.sigmas.back();
+  auto i = static_cast<std::size_t>(it - e.begin()) - 1;
+  G4double f = (energy - e[i]) / (e[i + 1] - e[i]);
+  return data.sigmas[i] + f * (data.sigmas[i + 1] - data.sigmas[i]);
+}
+
+void TritiumCrossSections::Build(const VolumeRegistry& volumes)
+{
+  fLogEMin = std::log(gridEMin);
+  fPointsPerLogUnit = gridPointsPerDecade / std::log(10.);
+  fNPoints = static_cast<G4int>((std::log(gridEMax) - fLogEMin) * fPointsPerLogUnit) + 2;
+
+  fActive = IsTabulated();
+  fTables.assign(volumes.GetNumberOfLayers(), {});
+  if (!fActive) return;
+
+  for (G4int layer = 0; layer < volumes.GetNumberOfLayers(); ++layer) {
+    const G4Material* material = volumes.GetLayerMaterial(layer);
+    const G4double* atomsPerVolume = material->GetVecNbOfAtomsPerVolume();
+
+    for (std::size_t i = 0; i < material->GetNumberOfElements(); ++i) {
+      const G4Element* element = material->GetElement(i);
+      if (element->GetZasInt() != 3) continue;
+
+      auto& table = fTables[layer];
+      if (table.empty()) table.assign(fNPoints, 0.);
+      for (G4int point = 0; point < fNPoints; ++point) {
+        G4double energy = std::exp(fLogEMin + point / fPointsPerLogUnit);
+        G4double sigma = 0.;
+        const G4double* abundances = element->GetRelativeAbundanceVector();
+        for (std::size_t k = 0; k < element->GetNumberOfIsotopes(); ++k) {
+          G4int massNumber = element->GetIsotope(k)->GetN();
+          if (massNumber == 6) sigma += abundances[k] * GetIsotopeSigma(fLi6, energy);
+          if (massNumber == 7) sigma += abundances[k] * GetIsotopeSigma(fLi7, energy);
+        }
+        table[point] += atomsPerVolume[i] * sigma;
+      }
+    }
+  }
+}
+
+G4String TritiumCrossSections::GetDescription() const
+{
+  if (!IsTabulated()) return "no (n,t) data";
+  return G4String("tabulated (n,t) data for") + (fLi6.energies.empty() ? "" : " Li-6")
+         + (fLi7.energies.empty() ? "" : " Li-7");
+}
+
+}  // namespace B1
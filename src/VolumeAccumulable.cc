@@ -0,0 +1,56 @@
+/// \file B1/src/VolumeAccumulable.cc
+/// \brief Implementation of the B1::VolumeAccumulable class
+
+#include "VolumeAccumulable.hh"
+
+#include "G4ios.hh"
+
+#include <algorithm>
+
+namespace B1
+{
+
+VolumeAccumulable::VolumeAccumulable(const G4String& name)
+  : G4VAccumulable(name)
+{}
+
+void VolumeAccumulable::Merge(const G4VAccumulable& other)
+{
+  const auto& rhs = static_cast<const VolumeAccumulable&>(other);
+  if (rhs.fSum.size() != fSum.size()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot merge " << GetName() << ": " << rhs.fSum.size()
+        << " entries into " << fSum.size() << ".";
+    G4Exception("VolumeAccumulable::Merge()", "B1Acc0001", FatalException, msg);
+    return;
+  }
+
+  for (std::size_t i = 0; i < fSum.size(); ++i) {
+    fSum[i] += rhs.fSum[i];
+    fSum2[i] += rhs.fSum2[i];
+  }
+}
+
+void VolumeAccumulable::Reset()
+{
+  std::fill(fSum.begin(), fSum.end(), 0.);
+  std::fill(fSum2.begin(), fSum2.end(), 0.);
+}
+
+void VolumeAccumulable::Print(G4PrintOptions) const
+{
+  G4cout << GetName() << ":" << G4endl;
+  for (std::size_t i = 0; i < fSum.size(); ++i) {
+    G4cout << "  " << fLabels[i] << ": " << fSum[i] << " (sum2 " << fSum2[i] << ")"
+           << G4endl;
+  }
+}
+
+void VolumeAccumulable::SetLabels(const std::vector<G4String>& labels)
+{
+  fLabels = labels;
+  fSum.assign(labels.size(), 0.);
+  fSum2.assign(labels.size(), 0.);
+}
+
+}  // namespace B1
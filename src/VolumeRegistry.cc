@@ -0,0 +1,130 @@
+/// \file B1/src/VolumeRegistry.cc
+/// \brief Implementation of the B1::VolumeRegistry class
+
+#include "VolumeRegistry.hh"
+
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4NucleiProperties.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4VSolid.hh"
+
+#include <algorithm>
+
+namespace B1
+{
+
+void VolumeRegistry::Clear()
+{
+  fNames.clear();
+  fLogicals.clear();
+  fKinds.clear();
+  fForcedCollision.clear();
+  fMasses.clear();
+  fNetVolumes.clear();
+  fTransitions.clear();
+  fLayerIndex.clear();
+  fLayerIDs.clear();
+  fLayerVolumes.clear();
+  fLayerMaterials.clear();
+  fLayerFrontZ.clear();
+  fLayerBackZ.clear();
+  fDepthOrigin = 0.;
+  fSourceZ = 0.;
+  fSourceWidth = 0.;
+  fPhotoNeutronThreshold = DBL_MAX;
+}
+
+G4int VolumeRegistry::Register(const G4String& name, G4LogicalVolume* logical,
+                               VolumeKind kind)
+{
+  if (GetID(name) >= 0) {
+    G4ExceptionDescription msg;
+    msg << "Volume " << name << " is already registered.";
+    G4Exception("VolumeRegistry::Register()", "B1Vol0001", FatalException, msg);
+  }
+
+  // Grow the transition matrix, keeping the flags already set
+  G4int oldSize = GetSize();
+  G4int newSize = oldSize + 1;
+  std::vector<unsigned> transitions(newSize * newSize, kNone);
+  for (G4int from = 0; from < oldSize; ++from) {
+    std::copy_n(fTransitions.begin() + from * oldSize, oldSize,
+                transitions.begin() + from * newSize);
+  }
+  fTransitions.swap(transitions);
+
+  fNames.push_back(name);
+  fLogicals.push_back(logical);
+  fKinds.push_back(kind);
+  fForcedCollision.push_back(false);
+  fMasses.push_back(0.);
+  fNetVolumes.push_back(0.);
+  fLayerIndex.push_back(-1);
+  return oldSize;
+}
+
+G4int VolumeRegistry::GetID(const G4String& name) const
+{
+  auto it = std::find(fNames.begin(), fNames.end(), name);
+  return (it != fNames.end()) ? static_cast<G4int>(it - fNames.begin()) : -1;
+}
+
+void VolumeRegistry::AddTransition(G4int from, G4int to, unsigned flags)
+{
+  if (from < 0 || to < 0 || from >= GetSize() || to >= GetSize()) {
+    G4ExceptionDescription msg;
+    msg << "Transition " << from << " -> " << to << " outside of the "
+        << GetSize() << " registered volumes.";
+    G4Exception("VolumeRegistry::AddTransition()", "B1Vol0002", FatalException, msg);
+    return;
+  }
+  fTransitions[from * GetSize() + to] |= flags;
+}
+
+void VolumeRegistry::ComputeMasses()
+{
+  for (G4int id = 0; id < GetSize(); ++id) {
+    // Forced recomputation, without the daughters' masses
+    G4LogicalVolume* logical = fLogicals[id];
+    fMasses[id] = logical->GetMass(true, false);
+    fNetVolumes[id] = fMasses[id] / logical->GetMaterial()->GetDensity();
+  }
+
+  // Neutron separation energy S_n = M(Z, A-1) + m_n - M(Z, A) of every
+  // isotope, e.g. 1.67 MeV for Be-9 and 2.22 MeV for deuterium
+  fPhotoNeutronThreshold = DBL_MAX;
+  for (const G4LogicalVolume* logical : fLogicals) {
+    for (const G4Element* element : *logical->GetMaterial()->GetElementVector()) {
+      for (std::size_t i = 0; i < element->GetNumberOfIsotopes(); ++i) {
+        const G4Isotope* isotope = element->GetIsotope(i);
+        G4int a = isotope->GetN();
+        G4int z = isotope->GetZ();
+        // H-1 has no neutron, He-3 would leave a diproton
+        if (a - 1 < z || (a - 1 == z && z > 1)) continue;
+        if (element->GetRelativeAbundanceVector()[i] <= 0.) continue;
+        G4double separation = G4NucleiProperties::GetNuclearMass(a - 1, z) + neutron_mass_c2
+                              - G4NucleiProperties::GetNuclearMass(a, z);
+        fPhotoNeutronThreshold = std::min(fPhotoNeutronThreshold, separation);
+      }
+    }
+  }
+}
+
+void VolumeRegistry::SetLayer(G4int id, G4double frontZ, G4double backZ)
+{
+  if (id < 0 || id >= GetSize() || fLayerIndex[id] >= 0) {
+    G4ExceptionDescription msg;
+    msg << "Cannot declare volume " << id << " as a layer.";
+    G4Exception("VolumeRegistry::SetLayer()", "B1Vol0003", FatalException, msg);
+    return;
+  }
+  fLayerIndex[id] = GetNumberOfLayers();
+  fLayerIDs.push_back(id);
+  fLayerVolumes.push_back(fLogicals[id]->GetSolid()->GetCubicVolume());
+  fLayerMaterials.push_back(fLogicals[id]->GetMaterial());
+  fLayerFrontZ.push_back(frontZ);
+  fLayerBackZ.push_back(backZ);
+}
+
+}  // namespace B1
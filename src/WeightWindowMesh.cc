@@ -0,0 +1,223 @@
+/// \file B1/src/WeightWindowMesh.cc
+/// \brief Implementation of the B1::WeightWindowMesh class
+
+#include "WeightWindowMesh.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace B1
+{
+
+WeightWindowMesh::WeightWindowMesh() = default;
+
+WeightWindowMesh::Windows WeightWindowMesh::MakeDefault(G4int nCells,
+                                                        const EnergyBinning& groups)
+{
+  Windows windows;
+  windows.groups = groups;
+  windows.lowerWeights.assign(nCells * groups.GetNumberOfBins(), 1. / kSurvivalFactor);
+  return windows;
+}
+
+G4bool WeightWindowMesh::Read(const G4String& fileName, G4int nCells, Windows& windows)
+{
+  std::ifstream in(fileName);
+  if (!in.is_open()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open weight-window file " << fileName << "; windows unchanged.";
+    G4Exception("WeightWindowMesh::Read()", "B1Bias0003", JustWarning, msg);
+    return false;
+  }
+
+  // Comments stripped, the rest is one stream of tokens
+  std::ostringstream content;
+  std::string line;
+  while (std::getline(in, line)) {
+    content << line.substr(0, line.find('#')) << "\n";
+  }
+  std::istringstream is(content.str());
+
+  G4String keyword;
+  G4int nGroups = 0;
+  is >> keyword >> nGroups;
+  G4bool valid = (keyword == "groups" && nGroups > 0);
+  std::vector<G4double> edges(valid ? nGroups + 1 : 0);
+  for (auto& edge : edges) {
+    is >> edge;
+    edge *= MeV;
+  }
+  G4int cells = 0;
+  is >> keyword >> cells;
+  valid = valid && is && keyword == "cells" && cells == nCells;
+
+  std::vector<G4double> lowerWeights;
+  for (G4int cell = 0; valid && cell < nCells; ++cell) {
+    G4int index;
+    G4double zLow, zHigh;
+    is >> index >> zLow >> zHigh;
+    for (G4int group = 0; group < nGroups; ++group) {
+      G4double weight = 0.;
+      is >> weight;
+      lowerWeights.push_back(weight);
+    }
+    valid = is && index == cell;
+  }
+  valid = valid
+          && std::all_of(lowerWeights.begin(), lowerWeights.end(),
+                         [](G4double w) { return w > 0.; });
+  if (!valid) {
+    G4ExceptionDescription msg;
+    msg << "Weight-window file " << fileName << " is malformed or is not for " << nCells
+        << " cells; windows unchanged.";
+    G4Exception("WeightWindowMesh::Read()", "B1Bias0003", JustWarning, msg);
+    return false;
+  }
+
+  windows.groups = EnergyBinning(edges, "weight-window groups");
+  windows.lowerWeights = std::move(lowerWeights);
+  return true;
+}
+
+void WeightWindowMesh::Configure(const std::vector<G4double>& edges, G4double area,
+                                 const EnergyBinning& groups, G4int batchSize)
+{
+  fEdges = edges;
+  fInverseVolumes.clear();
+  std::vector<G4String> labels;
+  for (std::size_t cell = 0; cell + 1 < edges.size(); ++cell) {
+    fInverseVolumes.push_back(cm3 / ((edges[cell + 1] - edges[cell]) * area));
+    labels.push_back("cell" + std::to_string(cell));
+  }
+  fFlux.Configure(labels, groups);
+  fFlux.SetBatchSize(batchSize);
+}
+
+void WeightWindowMesh::Score(G4double z1, G4double z2, G4double energy, G4double trackLength)
+{
+  if (z1 > z2) std::swap(z1, z2);
+  G4int nCells = GetNumberOfCells();
+  G4int first = static_cast<G4int>(std::upper_bound(fEdges.begin(), fEdges.end(), z1)
+                                   - fEdges.begin()) - 1;
+  first = std::clamp(first, 0, nCells - 1);
+
+  // A step across z stays in one cell
+  G4double extent = z2 - z1;
+  if (extent <= 0.) {
+    fFlux.Fill(first, energy, trackLength * fInverseVolumes[first]);
+    return;
+  }
+  for (G4int cell = first; cell < nCells && fEdges[cell] < z2; ++cell) {
+    G4double overlap = std::min(z2, fEdges[cell + 1]) - std::max(z1, fEdges[cell]);
+    if (overlap > 0.) {
+      fFlux.Fill(cell, energy, trackLength * overlap / extent * fInverseVolumes[cell]);
+    }
+  }
+}
+
+WeightWindowMesh::Windows WeightWindowMesh::MakeWindows(G4int nofEvents) const
+{
+  G4int nCells = GetNumberOfCells();
+  const EnergyBinning& groups = fFlux.GetBinning();
+  G4int nGroups = groups.GetNumberOfBins();
+
+  // Reference: the brightest group of the front cell
+  G4double reference = 0.;
+  for (G4int group = 0; group < nGroups; ++group) {
+    reference = std::max(reference, fFlux.GetSum(0, group));
+  }
+  if (reference <= 0. || nofEvents == 0) {
+    G4Exception("WeightWindowMesh::MakeWindows()", "B1Bias0004", JustWarning,
+                "No flux in the front cell; writing windows centred on weight 1.");
+    return MakeDefault(nCells, groups);
+  }
+
+  Windows windows;
+  windows.groups = groups;
+  windows.lowerWeights.assign(nCells * nGroups, 0.);
+  for (G4int cell = 0; cell < nCells; ++cell) {
+    auto row = windows.lowerWeights.begin() + cell * nGroups;
+    G4double lowest = 0.;
+    for (G4int group = 0; group < nGroups; ++group) {
+      G4double weight = fFlux.GetSum(cell, group) / reference / kSurvivalFactor;
+      row[group] = weight;
+      if (weight > 0. && (lowest == 0. || weight < lowest)) lowest = weight;
+    }
+
+    // Groups the pilot never reached split whatever arrives there; a cell
+    // never reached takes the windows of the cell in front of it
+    for (G4int group = 0; group < nGroups; ++group) {
+      if (row[group] > 0.) continue;
+      row[group] = (lowest > 0.) ? lowest : *(row - nGroups + group);
+    }
+  }
+  return windows;
+}
+
+void WeightWindowMesh::WriteWindows(const G4String& fileName, const Windows& windows,
+                                    G4int runID, G4int nofEvents) const
+{
+  std::ofstream out(fileName, std::ios::trunc);
+  if (!out.is_open()) {
+    G4ExceptionDescription msg;
+    msg << "Cannot open " << fileName << " for writing.";
+    G4Exception("WeightWindowMesh::WriteWindows()", "B1Out0002", JustWarning, msg);
+    return;
+  }
+
+  const auto& edges = windows.groups.GetEdges();
+  G4int nGroups = windows.groups.GetNumberOfBins();
+  out << "# Weight windows for exampleB1 -b weightwindow, from run " << runID << ", "
+      << nofEvents << " events\n"
+      << "# lower weight bound w per z cell and energy group; window [w, " << kUpperFactor
+      << " w], survival weight " << kSurvivalFactor << " w\n"
+      << "groups " << nGroups << "\n";
+  for (auto edge : edges) {
+    out << edge / MeV << " ";
+  }
+  out << "\n# cell z_low[cm] z_high[cm] w per group\n"
+      << "cells " << GetNumberOfCells() << "\n";
+  for (G4int cell = 0; cell < GetNumberOfCells(); ++cell) {
+    out << cell << " " << fEdges[cell] / cm << " " << fEdges[cell + 1] / cm;
+    for (G4int group = 0; group < nGroups; ++group) {
+      out << " " << windows.lowerWeights[cell * nGroups + group];
+    }
+    out << "\n";
+  }
+}
+
+void WeightWindowMesh::WriteFlux(const G4String& fileName, G4int runID,
+                                 G4int nofEvents) const
+{
+  std::ostringstream header;
+  header << "# Weight-window mesh flux [cm-2 per source neutron], run " << runID << ", "
+         << nofEvents << " events\n"
+         << "# binning: " << fFlux.GetBinning().GetDescription() << ", errors over "
+         << fFlux.GetNumberOfBatches() << " batches\n";
+  for (G4int cell = 0; cell < GetNumberOfCells(); ++cell) {
+    header << "# cell" << cell << ": z from " << fEdges[cell] / cm << " to "
+           << fEdges[cell + 1] / cm << " cm\n";
+  }
+  fFlux.Write(fileName, header.str(), nofEvents);
+}
+
+void WeightWindowMesh::PrintSummary(std::ostream& out, G4int nofEvents) const
+{
+  for (G4int cell = 0; cell < GetNumberOfCells(); ++cell) {
+    G4double flux = 0.;
+    G4double largestError = 0.;
+    for (G4int group = 0; group < fFlux.GetBinning().GetNumberOfBins(); ++group) {
+      flux += fFlux.GetSum(cell, group);
+      largestError = std::max(largestError, fFlux.GetRelativeError(cell, group));
+    }
+    out << "Cell " << cell << " (z " << fEdges[cell] / cm << " to " << fEdges[cell + 1] / cm
+        << " cm): flux " << flux / nofEvents << " cm-2, largest group rel. error "
+        << largestError << "\n";
+  }
+}
+
+}  // namespace B1